@@ -0,0 +1,65 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+
+#include "LoadingScreenCVarOverrides.h"
+
+#include "HAL/IConsoleManager.h"
+
+FLoadingScreenCVarOverrides::~FLoadingScreenCVarOverrides()
+{
+    RestoreAll();
+}
+
+bool FLoadingScreenCVarOverrides::Override(const TCHAR* Name, const FString& Value)
+{
+    IConsoleVariable* Variable = IConsoleManager::Get().FindConsoleVariable(Name);
+    if (!Variable)
+    {
+        return false;
+    }
+
+    const uint32 SetBy = Variable->GetFlags() & ECVF_SetByMask;
+
+    const bool bAlreadySaved = SavedValues.ContainsByPredicate([Variable](const FSavedValue& Saved)
+    {
+        return Saved.Variable == Variable;
+    });
+
+    if (!bAlreadySaved)
+    {
+        FSavedValue& Saved = SavedValues.AddDefaulted_GetRef();
+        Saved.Name = Name;
+        Saved.Variable = Variable;
+        Saved.OriginalValue = Variable->GetString();
+        Saved.OriginalSetBy = SetBy;
+    }
+
+    // Setting with a lower priority than the current one would be rejected, so reuse it
+    Variable->Set(*Value, static_cast<EConsoleVariableFlags>(SetBy));
+    return true;
+}
+
+FString FLoadingScreenCVarOverrides::GetOriginalValue(const TCHAR* Name) const
+{
+    for (const FSavedValue& Saved : SavedValues)
+    {
+        if (Saved.Name.Equals(Name, ESearchCase::IgnoreCase))
+        {
+            return Saved.OriginalValue;
+        }
+    }
+
+    const IConsoleVariable* Variable = IConsoleManager::Get().FindConsoleVariable(Name);
+    return Variable ? Variable->GetString() : FString();
+}
+
+void FLoadingScreenCVarOverrides::RestoreAll()
+{
+    for (int32 Index = SavedValues.Num() - 1; Index >= 0; --Index)
+    {
+        const FSavedValue& Saved = SavedValues[Index];
+        Saved.Variable->Set(*Saved.OriginalValue, static_cast<EConsoleVariableFlags>(Saved.OriginalSetBy));
+    }
+
+    SavedValues.Reset();
+}
@@ -0,0 +1,39 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IConsoleVariable;
+
+/*
+* Temporarily overrides console variables, and restores them to exactly what they were.
+* Values are set with the priority the variable already had, so restoring doesn't leave it flagged as set by code.
+*/
+class FLoadingScreenCVarOverrides
+{
+public:
+	~FLoadingScreenCVarOverrides();
+
+	// Overrides the variable, remembering its original value the first time it's overridden. Returns false if it doesn't exist.
+	bool Override(const TCHAR* Name, const FString& Value);
+
+	// Returns the value the variable had before it was first overridden, or its current value if it isn't overridden.
+	FString GetOriginalValue(const TCHAR* Name) const;
+
+	// Restores every overridden variable, in reverse order.
+	void RestoreAll();
+
+	bool IsEmpty() const { return SavedValues.IsEmpty(); }
+
+private:
+	struct FSavedValue
+	{
+		FString Name;
+		IConsoleVariable* Variable = nullptr;
+		FString OriginalValue;
+		uint32 OriginalSetBy = 0;
+	};
+
+	TArray<FSavedValue> SavedValues;
+};
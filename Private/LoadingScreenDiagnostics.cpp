@@ -0,0 +1,31 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+
+#include "LoadingScreenDiagnostics.h"
+
+#include "Misc/Paths.h"
+#include "Misc/PackageName.h"
+
+FString LoadingScreenDiagnostics::GetReportDirectory()
+{
+    return FPaths::ProjectSavedDir() / TEXT("LoadingScreen");
+}
+
+static FString MakeReportBaseName(const FString& ReportName, const FString& MapName)
+{
+    // Map names arrive as long package names, only the short name is useful in a filename
+    FString ShortMapName = MapName.IsEmpty() ? FString(TEXT("NoMap")) : FPackageName::GetShortName(MapName);
+    ShortMapName = FPaths::MakeValidFileName(ShortMapName, TEXT('_'));
+
+    return FString::Printf(TEXT("%s_%s_%s"), *ReportName, *ShortMapName, *FDateTime::Now().ToString());
+}
+
+FString LoadingScreenDiagnostics::MakeReportPath(const FString& ReportName, const FString& MapName, const TCHAR* Extension)
+{
+    return GetReportDirectory() / FString::Printf(TEXT("%s.%s"), *MakeReportBaseName(ReportName, MapName), Extension);
+}
+
+FString LoadingScreenDiagnostics::MakeReportDirectoryPath(const FString& ReportName, const FString& MapName)
+{
+    return GetReportDirectory() / MakeReportBaseName(ReportName, MapName);
+}
@@ -0,0 +1,20 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+* Shared helpers for the reports the loading screen writes to disk.
+*/
+namespace LoadingScreenDiagnostics
+{
+	// The directory all loading screen reports are written to. Saved/LoadingScreen.
+	FString GetReportDirectory();
+
+	// Builds a unique, timestamped report path such as Saved/LoadingScreen/HotStacks_MapName_2025.01.01-12.00.00.txt
+	FString MakeReportPath(const FString& ReportName, const FString& MapName, const TCHAR* Extension);
+
+	// Builds a unique, timestamped directory path for reports made of several files, such as Saved/LoadingScreen/SlowLoad_MapName_2025.01.01-12.00.00
+	FString MakeReportDirectoryPath(const FString& ReportName, const FString& MapName);
+}
@@ -0,0 +1,117 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+
+#include "LoadingScreenLoadHistory.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/OutputDevice.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#include "LoadingScreenDiagnostics.h"
+
+namespace LoadingScreenLoadHistory
+{
+    // Weight of the latest load in the moving average of a map's load time.
+    static constexpr float LoadTimeSmoothing = 0.3f;
+}
+
+void FLoadingScreenLoadHistory::Load()
+{
+    FString JsonString;
+    if (!FFileHelper::LoadFileToString(JsonString, *GetHistoryPath()))
+    {
+        return;
+    }
+
+    TArray<TSharedPtr<FJsonValue>> Entries;
+    if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(JsonString), Entries))
+    {
+        return;
+    }
+
+    for (const TSharedPtr<FJsonValue>& Entry : Entries)
+    {
+        const TSharedPtr<FJsonObject>* Object = nullptr;
+        FString MapName;
+        if (!Entry.IsValid() || !Entry->TryGetObject(Object) || !(*Object)->TryGetStringField(TEXT("map"), MapName))
+        {
+            continue;
+        }
+
+        FMapLoadHistory& History = MapHistory.FindOrAdd(MapName);
+        History.NumLoads = static_cast<int32>((*Object)->GetNumberField(TEXT("loads")));
+        History.AverageSecs = static_cast<float>((*Object)->GetNumberField(TEXT("averageSecs")));
+        History.LatestSecs = static_cast<float>((*Object)->GetNumberField(TEXT("latestSecs")));
+    }
+}
+
+bool FLoadingScreenLoadHistory::Save() const
+{
+    if (MapHistory.IsEmpty())
+    {
+        return false;
+    }
+
+    FString JsonString;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+
+    Writer->WriteArrayStart();
+    for (const TPair<FString, FMapLoadHistory>& MapPair : MapHistory)
+    {
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("map"), MapPair.Key);
+        Writer->WriteValue(TEXT("loads"), MapPair.Value.NumLoads);
+        Writer->WriteValue(TEXT("averageSecs"), MapPair.Value.AverageSecs);
+        Writer->WriteValue(TEXT("latestSecs"), MapPair.Value.LatestSecs);
+        Writer->WriteObjectEnd();
+    }
+    Writer->WriteArrayEnd();
+    Writer->Close();
+
+    return FFileHelper::SaveStringToFile(JsonString, *GetHistoryPath());
+}
+
+float FLoadingScreenLoadHistory::Predict(const FString& MapName) const
+{
+    const FMapLoadHistory* History = MapHistory.Find(MapName);
+    return History ? History->AverageSecs : -1.0f;
+}
+
+void FLoadingScreenLoadHistory::Record(const FString& MapName, float LoadSecs)
+{
+    FMapLoadHistory& History = MapHistory.FindOrAdd(MapName);
+    History.AverageSecs = History.NumLoads > 0 ? FMath::Lerp(History.AverageSecs, LoadSecs, LoadingScreenLoadHistory::LoadTimeSmoothing) : LoadSecs;
+    History.LatestSecs = LoadSecs;
+    ++History.NumLoads;
+}
+
+void FLoadingScreenLoadHistory::Dump(FOutputDevice& Ar) const
+{
+    if (MapHistory.IsEmpty())
+    {
+        Ar.Log(TEXT("No loads recorded yet."));
+        return;
+    }
+
+    TArray<FString> MapNames;
+    MapHistory.GetKeys(MapNames);
+    MapNames.Sort([this](const FString& A, const FString& B)
+    {
+        return MapHistory[A].AverageSecs > MapHistory[B].AverageSecs;
+    });
+
+    Ar.Log(TEXT("Load time history per map, slowest first. Excludes the additional hold."));
+    for (const FString& MapName : MapNames)
+    {
+        const FMapLoadHistory& History = MapHistory[MapName];
+        Ar.Logf(TEXT("  %s: %d loads, average %.3f s, latest %.3f s"), *MapName, History.NumLoads, History.AverageSecs, History.LatestSecs);
+    }
+}
+
+FString FLoadingScreenLoadHistory::GetHistoryPath()
+{
+    return LoadingScreenDiagnostics::GetReportDirectory() / TEXT("LoadHistory.json");
+}
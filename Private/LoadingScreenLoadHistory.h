@@ -0,0 +1,44 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FOutputDevice;
+
+/*
+* Remembers how long loading each map took, to predict how long the next transition to it will take.
+* Kept across sessions in Saved/LoadingScreen, since the first load of a session is the one worth predicting.
+*/
+class FLoadingScreenLoadHistory
+{
+public:
+	// Reads the history from disk, if there is one.
+	void Load();
+
+	// Writes the history to disk. Returns false if there was nothing to write or writing failed.
+	bool Save() const;
+
+	// Returns the expected load time of the map in seconds, or a negative value if it has never been loaded.
+	float Predict(const FString& MapName) const;
+
+	// Adds a finished transition to the history of the map.
+	void Record(const FString& MapName, float LoadSecs);
+
+	// Prints the history, slowest first.
+	void Dump(FOutputDevice& Ar) const;
+
+private:
+	struct FMapLoadHistory
+	{
+		int32 NumLoads = 0;
+
+		// Moving average, so that content changes are picked up after a few loads
+		float AverageSecs = 0.0f;
+		float LatestSecs = 0.0f;
+	};
+
+	static FString GetHistoryPath();
+
+	TMap<FString, FMapLoadHistory> MapHistory;
+};
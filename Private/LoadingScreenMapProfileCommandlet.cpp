@@ -0,0 +1,232 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+
+#include "LoadingScreenMapProfileCommandlet.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+
+#include "LoadingScreenDiagnostics.h"
+#include "LoadingScreenPackageUtils.h"
+
+#include "DevCommons.h"
+
+ULoadingScreenMapProfileCommandlet::ULoadingScreenMapProfileCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 ULoadingScreenMapProfileCommandlet::Main(const FString& Params)
+{
+    TArray<FString> Tokens;
+    TArray<FString> Switches;
+    TMap<FString, FString> ParamsMap;
+    ParseCommandLine(*Params, Tokens, Switches, ParamsMap);
+
+    // The closure is computed from the registry, so it has to be complete before we start
+    IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+    AssetRegistry.SearchAllAssets(true);
+
+    const TArray<FName> Maps = GatherMaps(ParamsMap);
+    if (Maps.IsEmpty())
+    {
+        UE_LOG(VSLog, Error, TEXT("No maps to profile. Pass -Maps=/Game/Maps/A+/Game/Maps/B, -MapList=File.txt or -MapDir=/Game/Maps."));
+        return 1;
+    }
+
+    const bool bTimedLoad = Switches.Contains(TEXT("TimedLoad"));
+
+    const FString* MaxClosureMBParam = ParamsMap.Find(TEXT("MaxClosureMB"));
+    const int64 MaxClosureBytes = MaxClosureMBParam ? static_cast<int64>(FCString::Atod(**MaxClosureMBParam) * 1024.0 * 1024.0) : 0;
+
+    const FString* MaxClosurePackagesParam = ParamsMap.Find(TEXT("MaxClosurePackages"));
+    const int32 MaxClosurePackages = MaxClosurePackagesParam ? FCString::Atoi(**MaxClosurePackagesParam) : 0;
+
+    TArray<FMapProfile> Profiles;
+    Profiles.Reserve(Maps.Num());
+
+    int32 NumOverBudget = 0;
+    for (const FName MapName : Maps)
+    {
+        FMapProfile& Profile = Profiles.Add_GetRef(ProfileMap(MapName, bTimedLoad));
+
+        Profile.bOverBudget = (MaxClosureBytes > 0 && Profile.ClosureDiskSize > MaxClosureBytes) || (MaxClosurePackages > 0 && Profile.NumPackages > MaxClosurePackages);
+        if (Profile.bOverBudget)
+        {
+            ++NumOverBudget;
+            UE_LOG(VSLog, Error, TEXT("Map '%s' is over its load budget: %d packages, %.2f MB."), *MapName.ToString(), Profile.NumPackages, Profile.ClosureDiskSize / (1024.0 * 1024.0));
+        }
+        else
+        {
+            const FString LoadTime = Profile.LoadSecs >= 0.0 ? FString::Printf(TEXT("%.3f s"), Profile.LoadSecs) : FString(TEXT("n/a"));
+            UE_LOG(VSLog, Display, TEXT("Map '%s': %d packages, %d sync loaded references, %.2f MB, load %s."), *MapName.ToString(), Profile.NumPackages,
+                Profile.NumSyncLoadedReferences, Profile.ClosureDiskSize / (1024.0 * 1024.0), *LoadTime);
+        }
+    }
+
+    const FString* OutputParam = ParamsMap.Find(TEXT("Output"));
+    const FString OutputBase = OutputParam ? *OutputParam : FPaths::GetBaseFilename(LoadingScreenDiagnostics::MakeReportPath(TEXT("MapProfile"), TEXT("All"), TEXT("csv")), false);
+
+    const bool bWroteCsv = WriteCsv(OutputBase + TEXT(".csv"), Profiles);
+    const bool bWroteJson = WriteJson(OutputBase + TEXT(".json"), Profiles);
+    if (!bWroteCsv || !bWroteJson)
+    {
+        UE_LOG(VSLog, Error, TEXT("Failed to write the map profile to '%s'."), *OutputBase);
+        return 1;
+    }
+
+    UE_LOG(VSLog, Display, TEXT("Profiled %d maps, %d over budget. Report written to '%s'."), Profiles.Num(), NumOverBudget, *OutputBase);
+    return NumOverBudget > 0 ? 1 : 0;
+}
+
+TArray<FName> ULoadingScreenMapProfileCommandlet::GatherMaps(const TMap<FString, FString>& ParamsMap) const
+{
+    TArray<FString> MapNames;
+
+    if (const FString* MapsParam = ParamsMap.Find(TEXT("Maps")))
+    {
+        MapsParam->ParseIntoArray(MapNames, TEXT("+"));
+    }
+
+    if (const FString* MapListParam = ParamsMap.Find(TEXT("MapList")))
+    {
+        TArray<FString> Lines;
+        if (FFileHelper::LoadFileToStringArray(Lines, **MapListParam))
+        {
+            for (FString& Line : Lines)
+            {
+                Line.TrimStartAndEndInline();
+                if (!Line.IsEmpty() && !Line.StartsWith(TEXT("#")))
+                {
+                    MapNames.Add(Line);
+                }
+            }
+        }
+        else
+        {
+            UE_LOG(VSLog, Error, TEXT("Could not read map list '%s'."), **MapListParam);
+        }
+    }
+
+    if (const FString* MapDirParam = ParamsMap.Find(TEXT("MapDir")))
+    {
+        FARFilter Filter;
+        Filter.PackagePaths.Add(FName(**MapDirParam));
+        Filter.ClassPaths.Add(UWorld::StaticClass()->GetClassPathName());
+        Filter.bRecursivePaths = true;
+
+        TArray<FAssetData> MapAssets;
+        IAssetRegistry::GetChecked().GetAssets(Filter, MapAssets);
+        for (const FAssetData& MapAsset : MapAssets)
+        {
+            MapNames.Add(MapAsset.PackageName.ToString());
+        }
+    }
+
+    TArray<FName> Maps;
+    for (const FString& MapName : MapNames)
+    {
+        FString LongPackageName = MapName;
+        if (FPackageName::IsShortPackageName(MapName) && !FPackageName::SearchForPackageOnDisk(MapName, &LongPackageName))
+        {
+            UE_LOG(VSLog, Warning, TEXT("Could not find map '%s', skipping it."), *MapName);
+            continue;
+        }
+
+        Maps.AddUnique(FName(*LongPackageName));
+    }
+
+    return Maps;
+}
+
+ULoadingScreenMapProfileCommandlet::FMapProfile ULoadingScreenMapProfileCommandlet::ProfileMap(FName MapName, bool bTimedLoad) const
+{
+    FMapProfile Profile;
+    Profile.MapName = MapName;
+
+    TSet<FName> HardClosure;
+    TSet<FName> SoftReferences;
+    LoadingScreenPackageUtils::GetDependencyClosure(MapName, HardClosure, &SoftReferences);
+
+    Profile.NumPackages = HardClosure.Num();
+    Profile.NumSyncLoadedReferences = FMath::Max(HardClosure.Num() - 1, 0);
+    Profile.NumSoftReferences = SoftReferences.Num();
+
+    for (const FName PackageName : HardClosure)
+    {
+        Profile.ClosureDiskSize += FMath::Max<int64>(LoadingScreenPackageUtils::GetPackageDiskSize(PackageName), 0);
+    }
+
+    if (bTimedLoad)
+    {
+        // Start from a clean slate so that packages shared with the previous map are loaded again
+        CollectGarbage(RF_NoFlags);
+
+        const double StartTime = FPlatformTime::Seconds();
+        const UPackage* MapPackage = LoadPackage(nullptr, *MapName.ToString(), LOAD_None);
+        Profile.LoadSecs = FPlatformTime::Seconds() - StartTime;
+
+        if (!MapPackage)
+        {
+            UE_LOG(VSLog, Warning, TEXT("Timed load of '%s' failed."), *MapName.ToString());
+            Profile.LoadSecs = -1.0;
+        }
+
+        CollectGarbage(RF_NoFlags);
+    }
+
+    return Profile;
+}
+
+bool ULoadingScreenMapProfileCommandlet::WriteCsv(const FString& Path, const TArray<FMapProfile>& Profiles) const
+{
+    FString Csv = TEXT("Map,Packages,SyncLoadedReferences,SoftReferences,ClosureDiskSize,LoadSecs,OverBudget\n");
+    for (const FMapProfile& Profile : Profiles)
+    {
+        const FString LoadSecs = Profile.LoadSecs >= 0.0 ? FString::Printf(TEXT("%.4f"), Profile.LoadSecs) : FString(TEXT("n/a"));
+        Csv += FString::Printf(TEXT("%s,%d,%d,%d,%lld,%s,%d\n"), *Profile.MapName.ToString(), Profile.NumPackages, Profile.NumSyncLoadedReferences,
+            Profile.NumSoftReferences, Profile.ClosureDiskSize, *LoadSecs, Profile.bOverBudget ? 1 : 0);
+    }
+
+    return FFileHelper::SaveStringToFile(Csv, *Path);
+}
+
+bool ULoadingScreenMapProfileCommandlet::WriteJson(const FString& Path, const TArray<FMapProfile>& Profiles) const
+{
+    FString JsonString;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+
+    Writer->WriteArrayStart();
+    for (const FMapProfile& Profile : Profiles)
+    {
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("map"), Profile.MapName.ToString());
+        Writer->WriteValue(TEXT("numPackages"), Profile.NumPackages);
+        Writer->WriteValue(TEXT("numSyncLoadedReferences"), Profile.NumSyncLoadedReferences);
+        Writer->WriteValue(TEXT("numSoftReferences"), Profile.NumSoftReferences);
+        Writer->WriteValue(TEXT("closureDiskSize"), Profile.ClosureDiskSize);
+        if (Profile.LoadSecs >= 0.0)
+        {
+            Writer->WriteValue(TEXT("loadSecs"), Profile.LoadSecs);
+        }
+        else
+        {
+            Writer->WriteNull(TEXT("loadSecs"));
+        }
+        Writer->WriteValue(TEXT("overBudget"), Profile.bOverBudget);
+        Writer->WriteObjectEnd();
+    }
+    Writer->WriteArrayEnd();
+    Writer->Close();
+
+    return FFileHelper::SaveStringToFile(JsonString, *Path);
+}
@@ -0,0 +1,120 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+
+#include "LoadingScreenMemoryTracker.h"
+
+#include "Misc/OutputDevice.h"
+
+#include "DevCommons.h"
+
+LLM_DEFINE_TAG(LoadingScreen);
+
+static double ToMB(uint64 Bytes)
+{
+    return Bytes / (1024.0 * 1024.0);
+}
+
+void FLoadingScreenMemoryTracker::BeginTransition()
+{
+    FMemory::Memzero(Samples);
+    TransitionPeak = 0;
+    ProcessPeakAtBegin = FPlatformMemory::GetStats().PeakUsedPhysical;
+    bIsTracking = true;
+
+    Sample(ELoadingScreenMemoryPoint::Show);
+}
+
+void FLoadingScreenMemoryTracker::Sample(ELoadingScreenMemoryPoint Point)
+{
+    if (!bIsTracking)
+    {
+        return;
+    }
+
+    Samples[static_cast<int32>(Point)] = SampleUsedPhysical();
+}
+
+void FLoadingScreenMemoryTracker::Tick()
+{
+    if (bIsTracking)
+    {
+        SampleUsedPhysical();
+    }
+}
+
+void FLoadingScreenMemoryTracker::EndTransition(const FString& MapName)
+{
+    if (!bIsTracking)
+    {
+        return;
+    }
+
+    Sample(ELoadingScreenMemoryPoint::Reveal);
+    bIsTracking = false;
+
+    const uint64 ProcessPeak = FPlatformMemory::GetStats().PeakUsedPhysical;
+    if (ProcessPeak > ProcessPeakAtBegin)
+    {
+        TransitionPeak = FMath::Max(TransitionPeak, ProcessPeak);
+    }
+
+    FMapMemoryStats& Stats = MapStats.FindOrAdd(MapName);
+    ++Stats.NumTransitions;
+    Stats.LatestPeak = TransitionPeak;
+    Stats.HighestPeak = FMath::Max(Stats.HighestPeak, TransitionPeak);
+    FMemory::Memcpy(Stats.LatestSamples, Samples, sizeof(Samples));
+
+    UE_LOG(VSLog, Log, TEXT("Transition memory for '%s': show %.1f MB, PreLoadMap %.1f MB, PostLoadMap %.1f MB, reveal %.1f MB, peak %.1f MB."), *MapName,
+        ToMB(Samples[static_cast<int32>(ELoadingScreenMemoryPoint::Show)]), ToMB(Samples[static_cast<int32>(ELoadingScreenMemoryPoint::PreLoadMap)]),
+        ToMB(Samples[static_cast<int32>(ELoadingScreenMemoryPoint::PostLoadMap)]), ToMB(Samples[static_cast<int32>(ELoadingScreenMemoryPoint::Reveal)]), ToMB(TransitionPeak));
+}
+
+void FLoadingScreenMemoryTracker::Dump(FOutputDevice& Ar) const
+{
+    if (MapStats.IsEmpty())
+    {
+        Ar.Log(TEXT("No transitions recorded yet."));
+        return;
+    }
+
+    TArray<FString> MapNames;
+    MapStats.GetKeys(MapNames);
+    MapNames.Sort([this](const FString& A, const FString& B)
+    {
+        return MapStats[A].HighestPeak > MapStats[B].HighestPeak;
+    });
+
+    Ar.Log(TEXT("Transition memory per map, highest peak first. Samples are from the latest transition, 0 where the point wasn't reached."));
+    for (const FString& MapName : MapNames)
+    {
+        const FMapMemoryStats& Stats = MapStats[MapName];
+        Ar.Logf(TEXT("  %s: %d transitions, highest peak %.1f MB, latest peak %.1f MB (show %.1f, PreLoadMap %.1f, PostLoadMap %.1f, reveal %.1f MB)"),
+            *MapName, Stats.NumTransitions, ToMB(Stats.HighestPeak), ToMB(Stats.LatestPeak),
+            ToMB(Stats.LatestSamples[static_cast<int32>(ELoadingScreenMemoryPoint::Show)]), ToMB(Stats.LatestSamples[static_cast<int32>(ELoadingScreenMemoryPoint::PreLoadMap)]),
+            ToMB(Stats.LatestSamples[static_cast<int32>(ELoadingScreenMemoryPoint::PostLoadMap)]), ToMB(Stats.LatestSamples[static_cast<int32>(ELoadingScreenMemoryPoint::Reveal)]));
+    }
+}
+
+FString FLoadingScreenMemoryTracker::DescribeLatestTransition(const FString& MapName) const
+{
+    const FMapMemoryStats* Stats = MapStats.Find(MapName);
+    if (!Stats)
+    {
+        return FString();
+    }
+
+    FString Description;
+    Description += FString::Printf(TEXT("  Show:        %.2f MB\n"), ToMB(Stats->LatestSamples[static_cast<int32>(ELoadingScreenMemoryPoint::Show)]));
+    Description += FString::Printf(TEXT("  PreLoadMap:  %.2f MB\n"), ToMB(Stats->LatestSamples[static_cast<int32>(ELoadingScreenMemoryPoint::PreLoadMap)]));
+    Description += FString::Printf(TEXT("  PostLoadMap: %.2f MB\n"), ToMB(Stats->LatestSamples[static_cast<int32>(ELoadingScreenMemoryPoint::PostLoadMap)]));
+    Description += FString::Printf(TEXT("  Reveal:      %.2f MB\n"), ToMB(Stats->LatestSamples[static_cast<int32>(ELoadingScreenMemoryPoint::Reveal)]));
+    Description += FString::Printf(TEXT("  Peak:        %.2f MB\n"), ToMB(Stats->LatestPeak));
+    return Description;
+}
+
+uint64 FLoadingScreenMemoryTracker::SampleUsedPhysical()
+{
+    const uint64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+    TransitionPeak = FMath::Max(TransitionPeak, UsedPhysical);
+    return UsedPhysical;
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+class FOutputDevice;
+
+// Allocations made by the loading screen itself, such as the widget and the assets it keeps alive.
+LLM_DECLARE_TAG(LoadingScreen);
+
+// The points of a transition that process memory is sampled at.
+enum class ELoadingScreenMemoryPoint : uint8
+{
+	Show,
+	PreLoadMap,
+	PostLoadMap,
+	Reveal,
+
+	Num
+};
+
+/*
+* Samples process memory at the key points of each transition and tracks the peak in between,
+* since that's where the outgoing and incoming worlds overlap. Peaks are aggregated per map for budgeting.
+*/
+class FLoadingScreenMemoryTracker
+{
+public:
+	// Starts a transition, sampling the Show point.
+	void BeginTransition();
+
+	// Samples one of the points of the current transition. Does nothing if no transition is being tracked.
+	void Sample(ELoadingScreenMemoryPoint Point);
+
+	// Polls memory to catch the peak between the sampled points. Called every frame from the game thread.
+	void Tick();
+
+	// Samples the Reveal point, folds the transition into the per-map stats and logs it.
+	void EndTransition(const FString& MapName);
+
+	bool IsTracking() const { return bIsTracking; }
+
+	// Prints the per-map peaks, highest first.
+	void Dump(FOutputDevice& Ar) const;
+
+	// Describes the samples and peak of the latest transition to the map, one per line. Empty if it was never tracked.
+	FString DescribeLatestTransition(const FString& MapName) const;
+
+private:
+	struct FMapMemoryStats
+	{
+		int32 NumTransitions = 0;
+		uint64 HighestPeak = 0;
+		uint64 LatestPeak = 0;
+
+		// The samples of the latest transition, indexed by ELoadingScreenMemoryPoint. Zero if the point was never reached.
+		uint64 LatestSamples[static_cast<int32>(ELoadingScreenMemoryPoint::Num)] = {};
+	};
+
+	// Also updates the peak.
+	uint64 SampleUsedPhysical();
+
+	bool bIsTracking = false;
+
+	uint64 Samples[static_cast<int32>(ELoadingScreenMemoryPoint::Num)] = {};
+	uint64 TransitionPeak = 0;
+
+	// The process-lifetime peak when the transition began. If it grew, the new lifetime peak happened during the transition,
+	// which catches the peak inside the blocking LoadMap where we can't poll.
+	uint64 ProcessPeakAtBegin = 0;
+
+	TMap<FString, FMapMemoryStats> MapStats;
+};
@@ -0,0 +1,212 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+
+#include "LoadingScreenPackageTracker.h"
+
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/OutputDevice.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+#include "LoadingScreenPackageUtils.h"
+
+void FLoadingScreenPackageReport::Dump(FOutputDevice& Ar, int32 TopN) const
+{
+    Ar.Logf(TEXT("Package loads for transition to '%s': %d packages (%d sync, %d async), %.2f MB on disk, transition took %.3f seconds."),
+        *MapName, Packages.Num(), NumSyncLoads, NumAsyncLoads, TotalDiskSize / (1024.0 * 1024.0), Duration);
+
+    const int32 NumToPrint = FMath::Min(TopN, Packages.Num());
+    for (int32 Index = 0; Index < NumToPrint; ++Index)
+    {
+        const FLoadingScreenPackageLoadRecord& Record = Packages[Index];
+        const FString DurationString = Record.HasMeasuredDuration() ? FString::Printf(TEXT("%8.2f ms"), Record.GetDuration() * 1000.0) : FString(TEXT("     dep   "));
+
+        Ar.Logf(TEXT("  %3d. %s  %10.1f KB  %s  @%.3fs  %s"), Index + 1, *DurationString, Record.DiskSize / 1024.0,
+            Record.bSynchronous ? TEXT("sync ") : TEXT("async"), Record.EndTime, *Record.PackageName.ToString());
+    }
+}
+
+bool FLoadingScreenPackageReport::SaveAsJson(const FString& Path, int32 TopN) const
+{
+    FString JsonString;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("map"), MapName);
+    Writer->WriteValue(TEXT("durationSecs"), Duration);
+    Writer->WriteValue(TEXT("numPackages"), Packages.Num());
+    Writer->WriteValue(TEXT("numSyncLoads"), NumSyncLoads);
+    Writer->WriteValue(TEXT("numAsyncLoads"), NumAsyncLoads);
+    Writer->WriteValue(TEXT("totalDiskSize"), TotalDiskSize);
+
+    Writer->WriteArrayStart(TEXT("packages"));
+    const int32 NumToWrite = FMath::Min(TopN, Packages.Num());
+    for (int32 Index = 0; Index < NumToWrite; ++Index)
+    {
+        const FLoadingScreenPackageLoadRecord& Record = Packages[Index];
+
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("package"), Record.PackageName.ToString());
+        Writer->WriteValue(TEXT("durationSecs"), Record.GetDuration());
+        Writer->WriteValue(TEXT("completedAtSecs"), Record.EndTime);
+        Writer->WriteValue(TEXT("diskSize"), Record.DiskSize);
+        Writer->WriteValue(TEXT("numAssets"), Record.NumAssets);
+        Writer->WriteValue(TEXT("synchronous"), Record.bSynchronous);
+        Writer->WriteObjectEnd();
+    }
+    Writer->WriteArrayEnd();
+
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    return FFileHelper::SaveStringToFile(JsonString, *Path);
+}
+
+FLoadingScreenPackageTracker::FLoadingScreenPackageTracker()
+{
+    SyncLoadHandle = FCoreDelegates::OnSyncLoadPackage.AddRaw(this, &FLoadingScreenPackageTracker::HandleSyncLoadPackage);
+    AsyncLoadHandle = FCoreDelegates::OnAsyncLoadPackage.AddRaw(this, &FLoadingScreenPackageTracker::HandleAsyncLoadPackage);
+    EndLoadHandle = FCoreUObjectDelegates::OnEndLoadPackage.AddRaw(this, &FLoadingScreenPackageTracker::HandleEndLoadPackage);
+    AssetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddRaw(this, &FLoadingScreenPackageTracker::HandleAssetLoaded);
+}
+
+FLoadingScreenPackageTracker::~FLoadingScreenPackageTracker()
+{
+    FCoreDelegates::OnSyncLoadPackage.Remove(SyncLoadHandle);
+    FCoreDelegates::OnAsyncLoadPackage.Remove(AsyncLoadHandle);
+    FCoreUObjectDelegates::OnEndLoadPackage.Remove(EndLoadHandle);
+    FCoreUObjectDelegates::OnAssetLoaded.Remove(AssetLoadedHandle);
+}
+
+void FLoadingScreenPackageTracker::BeginTransition(const FString& MapName)
+{
+    bIsTracking = true;
+    TransitionMapName = MapName;
+    TransitionStartTime = FPlatformTime::Seconds();
+
+    PendingRequests.Reset();
+    Records.Reset();
+}
+
+FLoadingScreenPackageReport FLoadingScreenPackageTracker::EndTransition()
+{
+    FLoadingScreenPackageReport Report;
+    if (!bIsTracking)
+    {
+        return Report;
+    }
+
+    bIsTracking = false;
+
+    Report.MapName = TransitionMapName;
+    Report.Duration = FPlatformTime::Seconds() - TransitionStartTime;
+    Records.GenerateValueArray(Report.Packages);
+
+    // Sizes are looked up now rather than while loading, to keep the delegates cheap
+    for (FLoadingScreenPackageLoadRecord& Record : Report.Packages)
+    {
+        Record.DiskSize = LoadingScreenPackageUtils::GetPackageDiskSize(Record.PackageName);
+        Report.TotalDiskSize += FMath::Max<int64>(Record.DiskSize, 0);
+
+        if (Record.bSynchronous)
+        {
+            ++Report.NumSyncLoads;
+        }
+        else
+        {
+            ++Report.NumAsyncLoads;
+        }
+    }
+
+    // Measured loads first, longest at the top. Dependencies without a measured duration follow, largest first.
+    Report.Packages.Sort([](const FLoadingScreenPackageLoadRecord& A, const FLoadingScreenPackageLoadRecord& B)
+    {
+        if (A.HasMeasuredDuration() != B.HasMeasuredDuration())
+        {
+            return A.HasMeasuredDuration();
+        }
+
+        if (A.HasMeasuredDuration())
+        {
+            return A.GetDuration() > B.GetDuration();
+        }
+
+        return A.DiskSize > B.DiskSize;
+    });
+
+    PendingRequests.Reset();
+    Records.Reset();
+
+    return Report;
+}
+
+void FLoadingScreenPackageTracker::HandleSyncLoadPackage(const FString& PackageName)
+{
+    RecordRequest(PackageName);
+}
+
+void FLoadingScreenPackageTracker::HandleAsyncLoadPackage(const FString& PackageName)
+{
+    RecordRequest(PackageName);
+}
+
+void FLoadingScreenPackageTracker::HandleEndLoadPackage(const FEndLoadPackageContext& Context)
+{
+    if (!bIsTracking || !IsInGameThread())
+    {
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds() - TransitionStartTime;
+
+    for (const UPackage* Package : Context.LoadedPackages)
+    {
+        if (!Package)
+        {
+            continue;
+        }
+
+        const FName PackageName = Package->GetFName();
+
+        FLoadingScreenPackageLoadRecord& Record = Records.FindOrAdd(PackageName);
+        Record.PackageName = PackageName;
+        Record.EndTime = Now;
+        Record.bSynchronous = Context.bSynchronous;
+
+        double RequestTime = 0.0;
+        if (PendingRequests.RemoveAndCopyValue(PackageName, RequestTime))
+        {
+            Record.StartTime = RequestTime;
+        }
+    }
+}
+
+void FLoadingScreenPackageTracker::HandleAssetLoaded(UObject* Asset)
+{
+    if (!bIsTracking || !Asset || !IsInGameThread())
+    {
+        return;
+    }
+
+    FLoadingScreenPackageLoadRecord& Record = Records.FindOrAdd(Asset->GetPackage()->GetFName());
+    Record.PackageName = Asset->GetPackage()->GetFName();
+    ++Record.NumAssets;
+}
+
+void FLoadingScreenPackageTracker::RecordRequest(const FString& PackageName)
+{
+    // Requests made from other threads aren't timed, their packages still show up as dependencies
+    if (!bIsTracking || !IsInGameThread())
+    {
+        return;
+    }
+
+    // Keep the first request, repeated requests for an in-flight package don't restart its load
+    const FName LongPackageName = LoadingScreenPackageUtils::ToPackageName(PackageName);
+    if (!PendingRequests.Contains(LongPackageName))
+    {
+        PendingRequests.Add(LongPackageName, FPlatformTime::Seconds() - TransitionStartTime);
+    }
+}
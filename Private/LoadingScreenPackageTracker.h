@@ -0,0 +1,96 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FOutputDevice;
+class UObject;
+struct FEndLoadPackageContext;
+
+// A single package loaded during a transition.
+struct FLoadingScreenPackageLoadRecord
+{
+	FName PackageName;
+
+	// Seconds since the transition began. StartTime is negative if the package was pulled in as a dependency, since we never see its request.
+	double StartTime = -1.0;
+	double EndTime = 0.0;
+
+	int64 DiskSize = -1;
+
+	// Assets reported by the asset-loaded delegate. Only broadcast in some build configurations, so may stay at zero.
+	int32 NumAssets = 0;
+
+	bool bSynchronous = false;
+
+	bool HasMeasuredDuration() const { return StartTime >= 0.0; }
+	double GetDuration() const { return HasMeasuredDuration() ? EndTime - StartTime : -1.0; }
+};
+
+// Every package loaded between the loading screen being shown and hidden, sorted with the most expensive first.
+struct FLoadingScreenPackageReport
+{
+	FString MapName;
+
+	// Length of the transition in seconds.
+	double Duration = 0.0;
+
+	TArray<FLoadingScreenPackageLoadRecord> Packages;
+
+	int64 TotalDiskSize = 0;
+	int32 NumSyncLoads = 0;
+	int32 NumAsyncLoads = 0;
+
+	bool IsEmpty() const { return Packages.IsEmpty(); }
+
+	// Prints the summary and the TopN most expensive packages.
+	void Dump(FOutputDevice& Ar, int32 TopN) const;
+
+	// Writes the summary and the TopN most expensive packages as JSON. Returns false if the file couldn't be written.
+	bool SaveAsJson(const FString& Path, int32 TopN) const;
+};
+
+/*
+* Listens to the engine's package loading delegates while a transition is in progress, and records timing,
+* size and sync/async mode of every package that finishes loading. Produces a report when the transition ends.
+*/
+class FLoadingScreenPackageTracker
+{
+public:
+	FLoadingScreenPackageTracker();
+	~FLoadingScreenPackageTracker();
+
+	// Starts recording. Restarts if a transition is already being recorded.
+	void BeginTransition(const FString& MapName);
+
+	// Stops recording, and builds the report for the transition.
+	FLoadingScreenPackageReport EndTransition();
+
+	bool IsTracking() const { return bIsTracking; }
+
+private:
+	void HandleSyncLoadPackage(const FString& PackageName);
+	void HandleAsyncLoadPackage(const FString& PackageName);
+	void HandleEndLoadPackage(const FEndLoadPackageContext& Context);
+	void HandleAssetLoaded(UObject* Asset);
+
+	// Remembers when a package was requested, so that the load duration can be calculated once it finishes.
+	void RecordRequest(const FString& PackageName);
+
+	bool bIsTracking = false;
+
+	FString TransitionMapName;
+
+	double TransitionStartTime = 0.0;
+
+	// Request timestamps of packages that haven't finished loading yet.
+	TMap<FName, double> PendingRequests;
+
+	TMap<FName, FLoadingScreenPackageLoadRecord> Records;
+
+	FDelegateHandle SyncLoadHandle;
+	FDelegateHandle AsyncLoadHandle;
+	FDelegateHandle EndLoadHandle;
+	FDelegateHandle AssetLoadedHandle;
+};
@@ -0,0 +1,230 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+
+#include "LoadingScreenPackageUtils.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+#include "DevCommons.h"
+
+namespace LoadingScreenPackageUtils
+{
+    // Every cooked package depends on at least one native package, so a known package without any dependencies means they weren't serialized
+    static void WarnIfDependenciesMissing(IAssetRegistry& AssetRegistry, FName PackageName)
+    {
+        static bool bHasWarned = false;
+        if (bHasWarned || !AssetRegistry.GetAssetPackageDataCopy(PackageName).IsSet())
+        {
+            return;
+        }
+
+        TArray<FName> Dependencies;
+        AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+        if (Dependencies.IsEmpty())
+        {
+            bHasWarned = true;
+            UE_LOG(VSLog, Warning, TEXT("The asset registry has no dependencies for '%s'. Set bSerializeDependencies=true under [AssetRegistry] in DefaultEngine.ini, ")
+                TEXT("otherwise asset retention, footprint reports and menu prefetching do nothing in packaged builds."), *PackageName.ToString());
+        }
+    }
+}
+
+int64 LoadingScreenPackageUtils::GetPackageDiskSize(FName PackageName)
+{
+    if (PackageName.IsNone())
+    {
+        return -1;
+    }
+
+    if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+    {
+        TOptional<FAssetPackageData> PackageData = AssetRegistry->GetAssetPackageDataCopy(PackageName);
+        if (PackageData.IsSet() && PackageData->DiskSize >= 0)
+        {
+            return PackageData->DiskSize;
+        }
+    }
+
+    // Fall back to loose files on disk, which covers uncooked content
+    FString Filename;
+    if (FPackageName::DoesPackageExist(PackageName.ToString(), &Filename))
+    {
+        return IFileManager::Get().FileSize(*Filename);
+    }
+
+    return -1;
+}
+
+void LoadingScreenPackageUtils::GetDependencyClosure(FName RootPackage, TSet<FName>& OutHardClosure, TSet<FName>* OutSoftReferences)
+{
+    IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+    if (!AssetRegistry || RootPackage.IsNone())
+    {
+        return;
+    }
+
+    WarnIfDependenciesMissing(*AssetRegistry, RootPackage);
+
+    const UE::AssetRegistry::FDependencyQuery HardQuery(UE::AssetRegistry::EDependencyQuery::Hard);
+    const UE::AssetRegistry::FDependencyQuery SoftQuery(UE::AssetRegistry::EDependencyQuery::Soft);
+
+    TArray<FName> PackagesToVisit;
+    PackagesToVisit.Add(RootPackage);
+    OutHardClosure.Add(RootPackage);
+
+    TArray<FName> Dependencies;
+    while (!PackagesToVisit.IsEmpty())
+    {
+        const FName PackageName = PackagesToVisit.Pop();
+
+        Dependencies.Reset();
+        AssetRegistry->GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, HardQuery);
+        for (const FName Dependency : Dependencies)
+        {
+            if (FPackageName::IsScriptPackage(Dependency.ToString()))
+            {
+                continue;
+            }
+
+            bool bAlreadyInClosure = false;
+            OutHardClosure.Add(Dependency, &bAlreadyInClosure);
+            if (!bAlreadyInClosure)
+            {
+                PackagesToVisit.Add(Dependency);
+            }
+        }
+
+        if (OutSoftReferences)
+        {
+            Dependencies.Reset();
+            AssetRegistry->GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, SoftQuery);
+            for (const FName Dependency : Dependencies)
+            {
+                if (!FPackageName::IsScriptPackage(Dependency.ToString()))
+                {
+                    OutSoftReferences->Add(Dependency);
+                }
+            }
+        }
+    }
+
+    // Anything hard referenced somewhere else in the closure will be loaded anyway
+    if (OutSoftReferences)
+    {
+        for (const FName PackageName : OutHardClosure)
+        {
+            OutSoftReferences->Remove(PackageName);
+        }
+    }
+}
+
+void LoadingScreenPackageUtils::GetDirectSoftReferences(FName RootPackage, TArray<FName>& OutSoftReferences)
+{
+    IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+    if (!AssetRegistry || RootPackage.IsNone())
+    {
+        return;
+    }
+
+    WarnIfDependenciesMissing(*AssetRegistry, RootPackage);
+
+    TArray<FName> Dependencies;
+    AssetRegistry->GetDependencies(RootPackage, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::FDependencyQuery(UE::AssetRegistry::EDependencyQuery::Soft));
+
+    TArray<FAssetData> Assets;
+    for (const FName Dependency : Dependencies)
+    {
+        if (Dependency == RootPackage || FPackageName::IsScriptPackage(Dependency.ToString()))
+        {
+            continue;
+        }
+
+        Assets.Reset();
+        AssetRegistry->GetAssetsByPackageName(Dependency, Assets);
+        const bool bIsMap = Assets.ContainsByPredicate([](const FAssetData& Asset)
+        {
+            return (Asset.PackageFlags & PKG_ContainsMap) != 0 || Asset.IsInstanceOf(UWorld::StaticClass());
+        });
+
+        if (!bIsMap)
+        {
+            OutSoftReferences.AddUnique(Dependency);
+        }
+    }
+}
+
+void LoadingScreenPackageUtils::GetAssetPaths(TConstArrayView<FName> Packages, TArray<FSoftObjectPath>& OutAssetPaths)
+{
+    IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+    if (!AssetRegistry)
+    {
+        return;
+    }
+
+    TArray<FAssetData> Assets;
+    for (const FName PackageName : Packages)
+    {
+        Assets.Reset();
+        AssetRegistry->GetAssetsByPackageName(PackageName, Assets);
+        for (const FAssetData& Asset : Assets)
+        {
+            OutAssetPaths.Add(Asset.GetSoftObjectPath());
+        }
+    }
+}
+
+int64 LoadingScreenPackageUtils::GetLoadedClosureSize(FName RootPackage, int32* OutNumLoadedPackages)
+{
+    TSet<FName> Closure;
+    GetDependencyClosure(RootPackage, Closure);
+
+    int64 TotalSize = 0;
+    int32 NumLoadedPackages = 0;
+    for (const FName PackageName : Closure)
+    {
+        UPackage* Package = FindObjectFast<UPackage>(nullptr, PackageName);
+        if (!Package)
+        {
+            continue;
+        }
+
+        ++NumLoadedPackages;
+        ForEachObjectWithPackage(Package, [&TotalSize](UObject* Object)
+        {
+            if (Object->IsAsset())
+            {
+                TotalSize += Object->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+            }
+            return true;
+        }, false);
+    }
+
+    if (OutNumLoadedPackages)
+    {
+        *OutNumLoadedPackages = NumLoadedPackages;
+    }
+
+    return TotalSize;
+}
+
+FName LoadingScreenPackageUtils::ToPackageName(const FString& NameOrPath)
+{
+    FString PackageName = FPackageName::ObjectPathToPackageName(NameOrPath);
+
+    if (!FPackageName::IsValidLongPackageName(PackageName))
+    {
+        FString ConvertedName;
+        if (FPackageName::TryConvertFilenameToLongPackageName(PackageName, ConvertedName))
+        {
+            PackageName = MoveTemp(ConvertedName);
+        }
+    }
+
+    return FName(*PackageName);
+}
@@ -0,0 +1,40 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+* Package queries shared by the loading screen's trackers and reports.
+* Dependencies come from the asset registry. Packaged builds only have them if the registry is cooked with them:
+*
+*   [AssetRegistry]
+*   bSerializeDependencies=true
+*
+* in DefaultEngine.ini. Without it every query returns no dependencies, and a warning is logged the first time.
+*/
+namespace LoadingScreenPackageUtils
+{
+	// Returns the size of the package on disk in bytes, or -1 if it can't be determined.
+	// Prefers the asset registry, which also knows the size of packages stored in IoStore containers.
+	int64 GetPackageDiskSize(FName PackageName);
+
+	// Collects the root package and every package it references, recursively, using the asset registry.
+	// Hard references are loaded together with the root, soft references are only gathered one level deep and never followed.
+	// Native /Script/ packages are skipped since they are never loaded from disk.
+	void GetDependencyClosure(FName RootPackage, TSet<FName>& OutHardClosure, TSet<FName>* OutSoftReferences = nullptr);
+
+	// Collects the packages the root package soft references directly, without following them or its hard references.
+	// Native /Script/ packages and map packages are skipped, since loading a map is never part of opening what references it.
+	void GetDirectSoftReferences(FName RootPackage, TArray<FName>& OutSoftReferences);
+
+	// Adds the paths of the assets in each package, for requesting them through the streamable manager.
+	void GetAssetPaths(TConstArrayView<FName> Packages, TArray<FSoftObjectPath>& OutAssetPaths);
+
+	// Returns the estimated memory of the loaded assets in the root package and its hard dependencies, in bytes.
+	// Assets shared with anything else that is loaded are included, so this is an upper bound on what unloading the root would free.
+	int64 GetLoadedClosureSize(FName RootPackage, int32* OutNumLoadedPackages = nullptr);
+
+	// Converts whatever the loading delegates hand us (package names, object paths, or filenames) to a long package name.
+	FName ToPackageName(const FString& NameOrPath);
+}
@@ -0,0 +1,186 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+
+#include "LoadingScreenStallWatchdog.h"
+
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformStackWalk.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+
+#include "LoadingScreenDiagnostics.h"
+
+FLoadingScreenStallWatchdog::FLoadingScreenStallWatchdog()
+{
+    check(IsInGameThread());
+    GameThreadId = GGameThreadId;
+    WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FLoadingScreenStallWatchdog::~FLoadingScreenStallWatchdog()
+{
+    Stop();
+    WaitForThread();
+
+    FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+    WakeEvent = nullptr;
+}
+
+void FLoadingScreenStallWatchdog::Arm(const FString& MapName, float InSampleIntervalMs, int32 InMaxStackDepth, int32 InStacksInReport)
+{
+    if (IsArmed())
+    {
+        return;
+    }
+
+    // The previous thread may still be writing its report
+    WaitForThread();
+
+    TransitionName = MapName;
+    ReportPath = LoadingScreenDiagnostics::MakeReportPath(TEXT("HotStacks"), MapName, TEXT("txt"));
+    SampleIntervalMs = FMath::Max(InSampleIntervalMs, 1.0f);
+    MaxStackDepth = FMath::Clamp(InMaxStackDepth, 4, 128);
+    StacksInReport = FMath::Max(InStacksInReport, 1);
+    ArmedTimestamp = FPlatformTime::Seconds();
+    DisarmedTimestamp = ArmedTimestamp;
+
+    Samples.Reset();
+    TotalSamples = 0;
+    FailedSamples = 0;
+
+    bStopRequested = false;
+    WakeEvent->Reset();
+
+    // Above normal so the sampler still gets scheduled while the loader saturates the worker threads
+    Thread = FRunnableThread::Create(this, TEXT("LoadingScreenStallWatchdog"), 0, TPri_AboveNormal);
+}
+
+FString FLoadingScreenStallWatchdog::Disarm()
+{
+    if (!IsArmed())
+    {
+        return FString();
+    }
+
+    Stop();
+    return ReportPath;
+}
+
+bool FLoadingScreenStallWatchdog::IsArmed() const
+{
+    return Thread != nullptr && !bStopRequested;
+}
+
+uint32 FLoadingScreenStallWatchdog::Run()
+{
+    FPlatformStackWalk::InitStackWalking();
+
+    TArray<uint64> ScratchBuffer;
+    ScratchBuffer.SetNumZeroed(MaxStackDepth);
+
+    while (!bStopRequested)
+    {
+        TakeSample(ScratchBuffer);
+        WakeEvent->Wait(FMath::Max(1, FMath::RoundToInt(SampleIntervalMs)));
+    }
+
+    DisarmedTimestamp = FPlatformTime::Seconds();
+    WriteReport();
+
+    return 0;
+}
+
+void FLoadingScreenStallWatchdog::Stop()
+{
+    bStopRequested = true;
+
+    if (WakeEvent)
+    {
+        WakeEvent->Trigger();
+    }
+}
+
+void FLoadingScreenStallWatchdog::TakeSample(TArray<uint64>& ScratchBuffer)
+{
+    const uint32 Depth = FPlatformStackWalk::CaptureThreadStackBackTrace(GameThreadId, ScratchBuffer.GetData(), ScratchBuffer.Num());
+    if (Depth == 0)
+    {
+        // Not supported on this platform, or the thread couldn't be suspended this time around
+        ++FailedSamples;
+        return;
+    }
+
+    const uint32 StackHash = FCrc::MemCrc32(ScratchBuffer.GetData(), Depth * sizeof(uint64));
+
+    FStackSample& Sample = Samples.FindOrAdd(StackHash);
+    if (Sample.Frames.IsEmpty())
+    {
+        Sample.Frames.Append(ScratchBuffer.GetData(), Depth);
+    }
+
+    ++Sample.Count;
+    ++TotalSamples;
+}
+
+void FLoadingScreenStallWatchdog::WriteReport() const
+{
+    const double ArmedDuration = DisarmedTimestamp - ArmedTimestamp;
+
+    FString Report;
+    Report += FString::Printf(TEXT("Loading screen hot-stack report for '%s'\n"), *TransitionName);
+    Report += FString::Printf(TEXT("Armed for %.3f seconds, sampling every %.1f ms\n"), ArmedDuration, SampleIntervalMs);
+    Report += FString::Printf(TEXT("%d samples in %d unique stacks, %d failed samples\n\n"), TotalSamples, Samples.Num(), FailedSamples);
+
+    if (TotalSamples == 0)
+    {
+        Report += TEXT("No samples were captured. Callstack capture of other threads may not be supported on this platform.\n");
+    }
+    else
+    {
+        TArray<const FStackSample*> SortedSamples;
+        SortedSamples.Reserve(Samples.Num());
+        for (const TPair<uint32, FStackSample>& Pair : Samples)
+        {
+            SortedSamples.Add(&Pair.Value);
+        }
+
+        SortedSamples.Sort([](const FStackSample& A, const FStackSample& B)
+        {
+            return A.Count > B.Count;
+        });
+
+        const int32 NumToWrite = FMath::Min(StacksInReport, SortedSamples.Num());
+        for (int32 Index = 0; Index < NumToWrite; ++Index)
+        {
+            const FStackSample& Sample = *SortedSamples[Index];
+            const double Fraction = static_cast<double>(Sample.Count) / TotalSamples;
+
+            // Time is an estimate, each sample stands for an equal share of the armed duration
+            Report += FString::Printf(TEXT("#%d: %d samples (%.1f%%, ~%.0f ms)\n"), Index + 1, Sample.Count, Fraction * 100.0, Fraction * ArmedDuration * 1000.0);
+
+            for (const uint64 ProgramCounter : Sample.Frames)
+            {
+                FProgramCounterSymbolInfo SymbolInfo;
+                FPlatformStackWalk::ProgramCounterToSymbolInfo(ProgramCounter, SymbolInfo);
+
+                Report += FString::Printf(TEXT("    0x%016llx %s [%s:%d]\n"), ProgramCounter, ANSI_TO_TCHAR(SymbolInfo.FunctionName), ANSI_TO_TCHAR(SymbolInfo.Filename), SymbolInfo.LineNumber);
+            }
+
+            Report += TEXT("\n");
+        }
+    }
+
+    FFileHelper::SaveStringToFile(Report, *ReportPath);
+}
+
+void FLoadingScreenStallWatchdog::WaitForThread()
+{
+    if (Thread)
+    {
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+
+#include <atomic>
+
+class FEvent;
+class FRunnableThread;
+
+/*
+* Background thread that periodically samples the game thread's callstack while a transition is in progress.
+* Identical stacks are aggregated, and the hottest ones are symbolicated and written to Saved/LoadingScreen when disarmed.
+* Works without an attached profiler, so that slow loads on playtest machines can still be attributed.
+*/
+class FLoadingScreenStallWatchdog : public FRunnable
+{
+public:
+	FLoadingScreenStallWatchdog();
+	virtual ~FLoadingScreenStallWatchdog() override;
+
+	// Starts sampling the game thread. Waits for a previous report to finish writing if needed. Does nothing if already armed.
+	void Arm(const FString& MapName, float SampleIntervalMs, int32 MaxStackDepth, int32 StacksInReport);
+
+	// Stops sampling. The report is written by the sampling thread so the game thread doesn't pay for symbolication.
+	// Returns the path the report will be written to, or an empty string if the watchdog wasn't armed.
+	FString Disarm();
+
+	bool IsArmed() const;
+
+	// --- Begin FRunnable Interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	// --- End FRunnable Interface
+
+private:
+	struct FStackSample
+	{
+		TArray<uint64> Frames;
+		int32 Count = 0;
+	};
+
+	// Captures the game thread's stack once and adds it to the aggregated samples.
+	void TakeSample(TArray<uint64>& ScratchBuffer);
+
+	// Sorts, symbolicates and writes the aggregated samples to ReportPath.
+	void WriteReport() const;
+
+	// Blocks until the previous sampling thread has exited, and releases it.
+	void WaitForThread();
+
+	FRunnableThread* Thread = nullptr;
+
+	FEvent* WakeEvent = nullptr;
+
+	std::atomic<bool> bStopRequested = false;
+
+	// Captured on construction, which always happens on the game thread.
+	uint32 GameThreadId = 0;
+
+	// Everything below is written by the game thread before the sampling thread starts, and only touched by the sampling thread afterwards.
+	FString ReportPath;
+	FString TransitionName;
+	float SampleIntervalMs = 10.0f;
+	int32 MaxStackDepth = 48;
+	int32 StacksInReport = 20;
+	double ArmedTimestamp = 0.0;
+	double DisarmedTimestamp = 0.0;
+
+	// Unique stacks keyed by the CRC of their frames.
+	TMap<uint32, FStackSample> Samples;
+	int32 TotalSamples = 0;
+	int32 FailedSamples = 0;
+};
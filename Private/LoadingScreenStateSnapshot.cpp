@@ -0,0 +1,47 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+
+#include "LoadingScreenStateSnapshot.h"
+
+void FLoadingScreenStatePublisher::Publish(const FLoadingScreenStateSnapshot& Snapshot)
+{
+    const uint32 StartSequence = Sequence.load(std::memory_order_relaxed);
+
+    // Odd while writing, the fence keeps the field stores from moving above it
+    Sequence.store(StartSequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    bIsVisible.store(Snapshot.bIsVisible, std::memory_order_relaxed);
+    Phase.store(static_cast<uint8>(Snapshot.Phase), std::memory_order_relaxed);
+    Progress.store(Snapshot.Progress, std::memory_order_relaxed);
+    HoldTimeRemaining.store(Snapshot.HoldTimeRemaining, std::memory_order_relaxed);
+    NumActiveRequests.store(Snapshot.NumActiveRequests, std::memory_order_relaxed);
+
+    Sequence.store(StartSequence + 2, std::memory_order_release);
+}
+
+FLoadingScreenStateSnapshot FLoadingScreenStatePublisher::Read() const
+{
+    FLoadingScreenStateSnapshot Snapshot;
+
+    uint32 StartSequence = 0;
+    uint32 EndSequence = 0;
+    do
+    {
+        StartSequence = Sequence.load(std::memory_order_acquire);
+
+        Snapshot.bIsVisible = bIsVisible.load(std::memory_order_relaxed);
+        Snapshot.Phase = static_cast<ELoadingScreenPhase>(Phase.load(std::memory_order_relaxed));
+        Snapshot.Progress = Progress.load(std::memory_order_relaxed);
+        Snapshot.HoldTimeRemaining = HoldTimeRemaining.load(std::memory_order_relaxed);
+        Snapshot.NumActiveRequests = NumActiveRequests.load(std::memory_order_relaxed);
+
+        // Keeps the field loads from moving below the second sequence load
+        std::atomic_thread_fence(std::memory_order_acquire);
+        EndSequence = Sequence.load(std::memory_order_relaxed);
+    }
+    while ((StartSequence & 1) != 0 || StartSequence != EndSequence);
+
+    Snapshot.Version = StartSequence / 2;
+    return Snapshot;
+}
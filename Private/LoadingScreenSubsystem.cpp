@@ -6,21 +6,185 @@
 #include "Engine/GameInstance.h"
 #include "Engine/GameViewportClient.h"
 #include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "ContentStreaming.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/Level.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/PendingNetGame.h"
+#include "GameFeaturesSubsystem.h"
+#include "GameFramework/PlayerStart.h"
+#include "WorldPartition/DataLayer/DataLayerInstance.h"
+#include "WorldPartition/DataLayer/DataLayerManager.h"
+#include "WorldPartition/WorldPartitionSubsystem.h"
 
 #include "LoadingScreenSettings.h"
+#include "LoadingScreenCVarOverrides.h"
+#include "LoadingScreenDiagnostics.h"
+#include "LoadingScreenLoadHistory.h"
+#include "LoadingScreenMemoryTracker.h"
+#include "LoadingScreenPackageTracker.h"
+#include "LoadingScreenPackageUtils.h"
+#include "LoadingScreenReadinessProvider.h"
+#include "LoadingScreenStallWatchdog.h"
+#include "LoadingScreenSyncLoadTracker.h"
+#include "LoadingScreenTickThrottler.h"
 
 #include "Framework/Application/SlateApplication.h" // For prompting slate tick
+#include "Rendering/SlateRenderer.h"
+#include "RenderingThread.h"
+#include "Slate/SRetainerWidget.h"
+#include "Slate/WidgetRenderer.h"
+#include "Widgets/SInvalidationPanel.h"
+#include "Engine/TextureRenderTarget2D.h"
 
 #include "Widgets/Images/SThrobber.h" // Fallback widget
+#include "Widgets/Layout/SBox.h"
 #include "Blueprint/UserWidget.h"
 
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "ProfilingDebugging/TraceAuxiliary.h"
+#include "Misc/App.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
 #include "DevCommons.h"
 
+// Written by the subsystem on the game thread, read by GetStateSnapshot from anywhere
+static FLoadingScreenStatePublisher GLoadingScreenStatePublisher;
+
+static const ULoadingScreenSubsystem* FindLoadingScreenSubsystem(const UWorld* World, FOutputDevice& Ar)
+{
+    const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+    const ULoadingScreenSubsystem* Subsystem = GameInstance ? GameInstance->GetSubsystem<ULoadingScreenSubsystem>() : nullptr;
+    if (!Subsystem)
+    {
+        Ar.Log(TEXT("No loading screen subsystem in this world."));
+    }
+
+    return Subsystem;
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LoadingScreenPackageReportCommand(
+    TEXT("LoadingScreen.PackageReport"),
+    TEXT("Prints the packages loaded during the latest loading screen transition, most expensive first. Usage: LoadingScreen.PackageReport [TopN]"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        if (const ULoadingScreenSubsystem* Subsystem = FindLoadingScreenSubsystem(World, Ar))
+        {
+            const int32 TopN = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : GetDefault<ULoadingScreenSettings>()->PackageLoadReportTopN;
+            Subsystem->DumpPackageLoadReport(Ar, FMath::Max(TopN, 1));
+        }
+    }));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LoadingScreenMemoryReportCommand(
+    TEXT("LoadingScreen.MemoryReport"),
+    TEXT("Prints the peak process memory of loading screen transitions, per map, highest first."),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        if (const ULoadingScreenSubsystem* Subsystem = FindLoadingScreenSubsystem(World, Ar))
+        {
+            Subsystem->DumpMemoryReport(Ar);
+        }
+    }));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LoadingScreenSyncLoadReportCommand(
+    TEXT("LoadingScreen.SyncLoadReport"),
+    TEXT("Prints the synchronous loads and async loading flushes that hitched gameplay outside the loading screen, per map."),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        if (const ULoadingScreenSubsystem* Subsystem = FindLoadingScreenSubsystem(World, Ar))
+        {
+            Subsystem->DumpSyncLoadReport(Ar);
+        }
+    }));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LoadingScreenResidencyReportCommand(
+    TEXT("LoadingScreen.ResidencyReport"),
+    TEXT("Prints the memory footprint and load time of the loading screen widget, and what each residency policy costs with them."),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        if (const ULoadingScreenSubsystem* Subsystem = FindLoadingScreenSubsystem(World, Ar))
+        {
+            Subsystem->DumpResidencyReport(Ar);
+        }
+    }));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LoadingScreenLoadHistoryCommand(
+    TEXT("LoadingScreen.LoadHistory"),
+    TEXT("Prints the load time history per map that the presentation tier is predicted from."),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        if (const ULoadingScreenSubsystem* Subsystem = FindLoadingScreenSubsystem(World, Ar))
+        {
+            Subsystem->DumpLoadHistory(Ar);
+        }
+    }));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LoadingScreenSlateReportCommand(
+    TEXT("LoadingScreen.SlateReport"),
+    TEXT("Prints the Slate time per frame while the loading screen was up, for each widget wrapping used so far."),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        if (const ULoadingScreenSubsystem* Subsystem = FindLoadingScreenSubsystem(World, Ar))
+        {
+            Subsystem->DumpSlateReport(Ar);
+        }
+    }));
+
 // USubsystem Begin
 void ULoadingScreenSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
     FCoreUObjectDelegates::PreLoadMapWithContext.AddUObject(this, &ThisClass::HandlePreLoadMap);
     FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::HandlePostLoadMap);
+    GEngine->OnTravelFailure().AddUObject(this, &ThisClass::HandleTravelFailure);
+
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+    if (Settings->bTrackPackageLoads)
+    {
+        PackageTracker = MakeShared<FLoadingScreenPackageTracker>();
+    }
+
+    if (Settings->bTrackSyncLoadsOutsideLoadingScreen)
+    {
+        SyncLoadTracker = MakeShared<FLoadingScreenSyncLoadTracker>(Settings->bCaptureSyncLoadCallstacks, Settings->SyncLoadMinDurationMs, Settings->bLogSyncLoadsOutsideLoadingScreen);
+    }
+
+    if (Settings->bTrackTransitionMemory)
+    {
+        MemoryTracker = MakeShared<FLoadingScreenMemoryTracker>();
+    }
+
+    if (Settings->bUseTieredPresentation)
+    {
+        LoadHistory = MakeShared<FLoadingScreenLoadHistory>();
+        LoadHistory->Load();
+    }
+
+    TickThrottler = MakeShared<FLoadingScreenTickThrottler>();
+
+    if (Settings->WidgetResidencyPolicy == ELoadingScreenResidencyPolicy::AlwaysResident)
+    {
+        PreloadLoadingScreenAssets();
+    }
+
+    if (FSlateApplication::IsInitialized() && FSlateApplication::Get().GetRenderer())
+    {
+        FSlateApplication::Get().GetRenderer()->OnSlateWindowRendered().AddUObject(this, &ThisClass::HandleSlateWindowRendered);
+        FSlateApplication::Get().OnPreTick().AddUObject(this, &ThisClass::HandleSlatePreTick);
+
+        // Before the first map load, which is usually the first show
+        if (Settings->bPrewarmWidgetAtStartup && FApp::CanEverRender())
+        {
+            PrewarmWidget();
+        }
+    }
 
     const UGameInstance* LocalGameInstance = GetGameInstance();
 
@@ -33,9 +197,73 @@ void ULoadingScreenSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 void ULoadingScreenSubsystem::Deinitialize()
 {
     RemoveWidget();
+    ReleaseWidgetAssets();
+
+    if (FSlateApplication::IsInitialized() && FSlateApplication::Get().GetRenderer())
+    {
+        FSlateApplication::Get().GetRenderer()->OnSlateWindowRendered().RemoveAll(this);
+        FSlateApplication::Get().OnPreTick().RemoveAll(this);
+    }
+
+    DisarmStallWatchdog();
+    StallWatchdog.Reset();
+
+    PackageTracker.Reset();
+
+    if (SyncLoadTracker.IsValid() && SyncLoadTracker->HasRecordedHitches())
+    {
+        const FString ReportPath = LoadingScreenDiagnostics::MakeReportPath(TEXT("SyncLoads"), FString(TEXT("Session")), TEXT("json"));
+        if (SyncLoadTracker->SaveAsJson(ReportPath))
+        {
+            UE_LOG(VSLog, Log, TEXT("Sync loads outside the loading screen written to '%s'."), *ReportPath);
+        }
+    }
+    SyncLoadTracker.Reset();
+
+    if (LoadHistory.IsValid())
+    {
+        LoadHistory->Save();
+        LoadHistory.Reset();
+    }
 
     FCoreUObjectDelegates::PreLoadMap.RemoveAll(this);
     FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
+    GEngine->OnTravelFailure().RemoveAll(this);
+
+    TravelState = ELoadingScreenTravelState::None;
+    PreloadedWorld = nullptr;
+    ResetTravelIntent();
+    ReleaseRetainedAssets();
+    PendingGameFeaturePlugins.Reset();
+    ReadinessProviders.Reset();
+
+    for (FMenuTransitionRequest& Request : PendingMenuTransitions)
+    {
+        if (Request.Handle.IsValid())
+        {
+            Request.Handle->CancelHandle();
+        }
+    }
+    PendingMenuTransitions.Reset();
+
+    for (TPair<TWeakObjectPtr<UUserWidget>, TSharedPtr<FStreamableHandle>>& MenuAssets : MenuAssetHandles)
+    {
+        MenuAssets.Value->ReleaseHandle();
+    }
+    MenuAssetHandles.Reset();
+
+    // Restores anything still throttled
+    TickThrottler.Reset();
+
+    // Don't leave other threads believing we're still loading
+    GLoadingScreenStatePublisher.Publish(FLoadingScreenStateSnapshot());
+
+    if (LevelStreamingOverrides.IsValid())
+    {
+        LevelStreamingOverrides->RestoreAll();
+    }
+
+    EndQualityRamp();
 }
 
 bool ULoadingScreenSubsystem::ShouldCreateSubsystem(UObject* Outer) const
@@ -52,7 +280,29 @@ bool ULoadingScreenSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 
 void ULoadingScreenSubsystem::Tick(float DeltaTime)
 {
+    if (SyncLoadTracker.IsValid())
+    {
+        SyncLoadTracker->Tick();
+    }
+
+    if (MemoryTracker.IsValid())
+    {
+        MemoryTracker->Tick();
+    }
+
     UpdateLoadingScreen();
+
+    UpdateQualityRamp();
+
+    // Menus that have been closed and collected no longer need their assets
+    for (int32 Index = MenuAssetHandles.Num() - 1; Index >= 0; --Index)
+    {
+        if (!MenuAssetHandles[Index].Key.IsValid())
+        {
+            MenuAssetHandles[Index].Value->ReleaseHandle();
+            MenuAssetHandles.RemoveAtSwap(Index);
+        }
+    }
 }
 
 ETickableTickType ULoadingScreenSubsystem::GetTickableTickType() const
@@ -132,229 +382,2220 @@ float ULoadingScreenSubsystem::GetAdditionalTimeRemaining() const
     return Settings->HoldLoadingScreenAdditionalSecs - TimeSinceScreenDismissed;
 }
 
-void ULoadingScreenSubsystem::HandlePreLoadMap(const FWorldContext& WorldContext, const FString& MapName)
+void ULoadingScreenSubsystem::TravelWithPreload(const FString& MapName, const FString& Options)
 {
-    // Immediately update the loading screen once to initialize logic.
-    if (GEngine->IsInitialized())
+    if (TravelState != ELoadingScreenTravelState::None)
     {
-        UpdateLoadingScreen();
+        UE_LOG(VSLog, Warning, TEXT("TravelWithPreload to '%s' ignored, a travel to '%s' is already in progress."), *MapName, *PendingTravelMap);
+        return;
     }
-}
-
-void ULoadingScreenSubsystem::HandlePostLoadMap(UWorld* World)
-{
-}
-
-bool ULoadingScreenSubsystem::CheckForDisplayReason()
-{
-    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
 
-    // Forced in settings. Show loading screen!
-    if (Settings->bForceDisplayLoadingScreen == true)
+    // Short names are resolved the same way the engine resolves them when travelling
+    FString LongPackageName = MapName;
+    if (FPackageName::IsShortPackageName(MapName) && !FPackageName::SearchForPackageOnDisk(MapName, &LongPackageName))
     {
-        LoadingScreenStateReason = FString(TEXT("ForceDisplayLoadingScreen in settings is true"));
-        return true;
+        UE_LOG(VSLog, Warning, TEXT("TravelWithPreload could not resolve '%s' to a package, travelling without preloading."), *MapName);
+        LongPackageName = MapName;
     }
 
-    const UGameInstance* LocalGameInstance = GetGameInstance();
+    PendingTravelMap = LongPackageName;
+    PendingTravelOptions = Options;
 
-    // No world context, probably no level. Show loading screen!
-    const FWorldContext* Context = LocalGameInstance->GetWorldContext();
-    if (!Context)
-    {
-        LoadingScreenStateReason = FString(TEXT("The game instance has a null WorldContext"));
-        return true;
-    }
+    // Passing through the transition map only makes sense if we'll be able to preload the destination from there
+    const FString TransitionMap = GetDefault<ULoadingScreenSettings>()->TransitionMap.GetLongPackageName();
+    UWorld* World = GetGameInstance()->GetWorld();
+    const bool bUseTransitionMap = World && !TransitionMap.IsEmpty() && TransitionMap != LongPackageName && FPackageName::IsValidLongPackageName(LongPackageName);
 
-	// No world, show loading screen!
-    UWorld* World = Context->World();
-    if (World == nullptr)
-    {
-        LoadingScreenStateReason = FString(TEXT("We have no world is null, FWorldContext's World()"));
-        return true;
-    }
+    TravelState = bUseTransitionMap ? ELoadingScreenTravelState::LoadingTransitionMap : ELoadingScreenTravelState::PreloadingDestination;
 
-	// World isnt ready, show loading screen!
-    if (!World->HasBegunPlay())
+    // Get the screen up right away, so that it animates while we load
+    UpdateLoadingScreen();
+
+    if (bUseTransitionMap)
     {
-        LoadingScreenStateReason = FString(TEXT("World hasn't begun play"));
-        return true;
+        // Continued in HandlePostLoadMap. The options belong to the destination, not the transition map.
+        GEngine->SetClientTravel(World, *TransitionMap, TRAVEL_Absolute);
+        return;
     }
 
-    // Game logic has requested the loading screen, show it!
-    if (bIsDisplayedByGameLogic == true)
+    StartTravelPreload();
+}
+
+void ULoadingScreenSubsystem::LoadAndActivateGameFeatures(const TArray<FString>& PluginNames)
+{
+    UGameFeaturesSubsystem& GameFeaturesSubsystem = UGameFeaturesSubsystem::Get();
+
+    // Register everything as pending before issuing any request, a request can complete synchronously
+    TArray<TPair<FString, FString>> Requests;
+    for (const FString& PluginName : PluginNames)
     {
-        if (UserSpecifiedLoadingScreenReason.IsEmpty())
+        FString PluginURL;
+        if (!GameFeaturesSubsystem.GetPluginURLByName(PluginName, PluginURL))
         {
-		    LoadingScreenStateReason = FString(TEXT("Reason not specified in ForceDisplayStateByGameLogic. Assumed gameplay logic."));
+            UE_LOG(VSLog, Error, TEXT("Could not find Game Feature plugin '%s', not waiting for it."), *PluginName);
+            continue;
         }
-        else
+
+        // Nothing to load, and it would bring the screen up only to hold it for no reason
+        if (GameFeaturesSubsystem.IsGameFeaturePluginActive(PluginURL))
         {
-            LoadingScreenStateReason = UserSpecifiedLoadingScreenReason;
+            continue;
         }
 
-		return true;
+        if (!PendingGameFeaturePlugins.Contains(PluginName))
+        {
+            PendingGameFeaturePlugins.Add(PluginName);
+            Requests.Emplace(PluginName, PluginURL);
+        }
     }
 
-    // No checks returned true, no reason to show
-    LoadingScreenStateReason = FString(TEXT("No reason to display."));
-    return false;
-}
-
-void ULoadingScreenSubsystem::UpdateLoadingScreen()
-{
-    if (ShouldShowLoadingScreen())
-    {
-		ShowLoadingScreen();
-	}
-    else
+    if (Requests.IsEmpty())
     {
-        HideLoadingScreen();
+        return;
     }
 
-    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
-    
-    if (Settings->bLogLoadingScreenReason == true)
+    // Get the screen up before the requests start, so the plugins load behind it
+    UpdateLoadingScreen();
+
+    // Issued back to back so the plugins load concurrently instead of one after another
+    for (const TPair<FString, FString>& Request : Requests)
     {
-        UE_LOG(VSLog, Log, TEXT("Loading screen display status: %d. Reason: %s"), bIsDisplayingLoadingScreen ? 1 : 0, *LoadingScreenStateReason);
+        const FString PluginName = Request.Key;
+        GameFeaturesSubsystem.LoadAndActivateGameFeaturePlugin(Request.Value, FGameFeaturePluginLoadComplete::CreateWeakLambda(this, [this, PluginName](const UE::GameFeatures::FResult& Result)
+        {
+            HandleGameFeatureLoadComplete(PluginName, Result.HasError() ? Result.GetError() : FString());
+        }));
     }
 }
 
-bool ULoadingScreenSubsystem::ShouldShowLoadingScreen()
+void ULoadingScreenSubsystem::RequestMenuTransition(TSoftClassPtr<UUserWidget> MenuWidgetClass, APlayerController* OwningPlayer, FOnMenuTransitionCompleteSignature OnComplete)
 {
-    bool bNeedToShowLoadingScreen = CheckForDisplayReason();
-
-    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
-
-    // Loading screen can be forced on bc of minimum on-times or other requirements.
-    bool bForcedToShowLoadingScreen = false;
-    if (bNeedToShowLoadingScreen)
+    if (MenuWidgetClass.IsNull())
     {
-        // Still need to show it for other reasons, dont update
-        LoadingScreenLastDismissedTimestamp = -1.0;
+        UE_LOG(VSLog, Error, TEXT("RequestMenuTransition was called without a widget class."));
+        OnComplete.ExecuteIfBound(nullptr);
+        return;
     }
-    else
-    {
-        const double CurrentTime = FPlatformTime::Seconds();
-        double HoldLoadingScreenTime = Settings->HoldLoadingScreenAdditionalSecs;
 
-        // If in editor and with waiting turned off, skip the additional time entirely
-        if (GIsEditor && Settings->bShowLoadingScreenAdditionalSecsInEditor == false)
+    // The class brings its hard references with it, its own soft ones are what the menu would otherwise load synchronously once open
+    TArray<FName> SoftReferences;
+    const int32 MaxPrefetchPackages = GetDefault<ULoadingScreenSettings>()->MaxMenuPrefetchPackages;
+    if (MaxPrefetchPackages > 0)
+    {
+        LoadingScreenPackageUtils::GetDirectSoftReferences(FName(*MenuWidgetClass.GetLongPackageName()), SoftReferences);
+        if (SoftReferences.Num() > MaxPrefetchPackages)
         {
-            HoldLoadingScreenTime = 0.0;
+            UE_LOG(VSLog, Verbose, TEXT("Menu '%s' soft references %d packages, only loading the first %d with it."), *MenuWidgetClass.ToString(), SoftReferences.Num(), MaxPrefetchPackages);
+            SoftReferences.SetNum(MaxPrefetchPackages);
         }
+    }
 
-        // Setup the timestamp the first time this is hit
-        if (LoadingScreenLastDismissedTimestamp < 0.0)
-        {
-            LoadingScreenLastDismissedTimestamp = CurrentTime;
-            OnHoldTimeTriggeredDelegate.Broadcast(HoldLoadingScreenTime);
-        }
-        const double TimeSinceScreenDismissed = CurrentTime - LoadingScreenLastDismissedTimestamp;
+    TArray<FSoftObjectPath> AssetPaths;
+    AssetPaths.Add(MenuWidgetClass.ToSoftObjectPath());
+    LoadingScreenPackageUtils::GetAssetPaths(SoftReferences, AssetPaths);
 
-        // Hold for an extra X seconds, to cover up geometry loading
-        if ((HoldLoadingScreenTime > 0.0) && (TimeSinceScreenDismissed < HoldLoadingScreenTime))
-        {
-            // Make sure we're rendering the world at this point, so that textures will actually stream in
-            UGameViewportClient* GameViewportClient = GetGameInstance()->GetGameViewportClient();
-            GameViewportClient->bDisableWorldRendering = false;
+    const int32 RequestId = NextMenuTransitionRequestId++;
 
-            LoadingScreenStateReason = FString::Printf(TEXT("Keeping loading screen up for an additional %.2f seconds to allow texture streaming"), Settings->HoldLoadingScreenAdditionalSecs);
-            bForcedToShowLoadingScreen = true;
-        }
-    }
+    FMenuTransitionRequest& Request = PendingMenuTransitions.AddDefaulted_GetRef();
+    Request.RequestId = RequestId;
+    Request.WidgetClass = MenuWidgetClass;
+    Request.OwningPlayer = OwningPlayer;
+    Request.OnComplete = OnComplete;
+    Request.StartTime = FPlatformTime::Seconds();
 
-    return bNeedToShowLoadingScreen || bForcedToShowLoadingScreen;
-}
+    // Started stalled so the handle is stored before the delegate can run, which it does right away if everything is already loaded
+    const TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetPaths, FStreamableDelegate::CreateWeakLambda(this, [this, RequestId]()
+    {
+        HandleMenuTransitionLoaded(RequestId);
+    }), FStreamableManager::AsyncLoadHighPriority, false, true, TEXT("LoadingScreenMenuTransition"));
 
-void ULoadingScreenSubsystem::ShowLoadingScreen()
-{
-    // Already onscreen
-    if (bIsDisplayingLoadingScreen)
+    if (!Handle.IsValid())
     {
+        HandleMenuTransitionLoaded(RequestId);
         return;
     }
-    
-    bIsDisplayingLoadingScreen = true;
 
-    OnVisibilityChangedDelegate.Broadcast(bIsDisplayingLoadingScreen);
+    Request.Handle = Handle;
+    Handle->StartStalledHandle();
+}
 
-    UGameInstance* LocalGameInstance = GetGameInstance();
+ELoadingScreenPhase ULoadingScreenSubsystem::GetCurrentPhase() const
+{
+    return bIsDisplayingLoadingScreen ? DisplayPhase : ELoadingScreenPhase::None;
+}
 
-    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+FLoadingScreenStateSnapshot ULoadingScreenSubsystem::GetStateSnapshot()
+{
+    return GLoadingScreenStatePublisher.Read();
+}
 
-    // Create and show widget
-    TSubclassOf<UUserWidget> LoadingScreenWidgetClass = Settings->LoadingScreenWidget.TryLoadClass<UUserWidget>();
-    if (UUserWidget* UserWidget = UUserWidget::CreateWidgetInstance(*LocalGameInstance, LoadingScreenWidgetClass, NAME_None))
+void ULoadingScreenSubsystem::RegisterTickThrottle(UObject* ActorOrComponent, ELoadingScreenTickPolicy Policy, float ReducedTickRateHz)
+{
+    if (TickThrottler.IsValid())
     {
-        LoadingScreenWidget = UserWidget->TakeWidget();
+        TickThrottler->RegisterObject(ActorOrComponent, Policy, ReducedTickRateHz);
     }
-    else
+}
+
+void ULoadingScreenSubsystem::UnregisterTickThrottle(UObject* ActorOrComponent)
+{
+    if (TickThrottler.IsValid())
     {
-        UE_LOG(VSLog, Error, TEXT("Failed to load the loading screen widget '%s', falling back to placeholder."), *Settings->LoadingScreenWidget.ToString());
-        LoadingScreenWidget = SNew(SThrobber);
+        TickThrottler->UnregisterObject(ActorOrComponent);
     }
+}
 
-    // Add to the viewport at a high ZOrder to make sure it is on top of most things
-    UGameViewportClient* GameViewportClient = LocalGameInstance->GetGameViewportClient();
-    GameViewportClient->AddViewportWidgetContent(LoadingScreenWidget.ToSharedRef(), Settings->ZOrder);
-
-    ChangePerformanceSettings(true);
+FDelegateHandle ULoadingScreenSubsystem::RegisterThrottledTicker(FName DebugName, const FTickerDelegate& Delegate, ELoadingScreenTickPolicy Policy, float ReducedTickRateHz)
+{
+    return TickThrottler.IsValid() ? TickThrottler->RegisterTicker(DebugName, Delegate, Policy, ReducedTickRateHz) : FDelegateHandle();
+}
 
-    if (!GIsEditor)
+void ULoadingScreenSubsystem::UnregisterThrottledTicker(FDelegateHandle Handle)
+{
+    if (TickThrottler.IsValid())
     {
-        // Tick Slate to make sure the loading screen is displayed immediately
-        FSlateApplication::Get().Tick();
+        TickThrottler->UnregisterTicker(Handle);
     }
 }
 
-void ULoadingScreenSubsystem::HideLoadingScreen()
+void ULoadingScreenSubsystem::PreloadLoadingScreenAssets()
 {
-    // Already offscreen
-    if (!bIsDisplayingLoadingScreen)
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+    if (Settings->WidgetResidencyPolicy == ELoadingScreenResidencyPolicy::LoadOnDemand || bIsDisplayingLoadingScreen || WidgetAssetsHandle.IsValid())
     {
         return;
     }
 
-    RemoveWidget();
+    if (Settings->LoadingScreenWidget.IsNull())
+    {
+        return;
+    }
 
-    ChangePerformanceSettings(false);
+    LLM_SCOPE_BYTAG(LoadingScreen);
 
-    bIsDisplayingLoadingScreen = false;
+    const double StartTime = FPlatformTime::Seconds();
+    WidgetAssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Settings->LoadingScreenWidget, FStreamableDelegate::CreateWeakLambda(this, [this, StartTime]()
+    {
+        RecordWidgetLoad(FPlatformTime::Seconds() - StartTime, false);
+    }), FStreamableManager::AsyncLoadHighPriority);
+}
 
-    OnVisibilityChangedDelegate.Broadcast(bIsDisplayingLoadingScreen);
+bool ULoadingScreenSubsystem::IsTravelPending() const
+{
+    return TravelState != ELoadingScreenTravelState::None;
 }
 
-void ULoadingScreenSubsystem::RemoveWidget()
+void ULoadingScreenSubsystem::RegisterReadinessProvider(TScriptInterface<ILoadingScreenReadinessProvider> Provider)
 {
-    // Gets the widget if the sharedptr is valid, before resetting it and destroying the object
-    UGameInstance* LocalGameInstance = GetGameInstance();
-    if (LoadingScreenWidget.IsValid())
+    UObject* ProviderObject = Provider.GetObject();
+    ILoadingScreenReadinessProvider* ProviderInterface = Provider.GetInterface();
+    if (!ProviderObject || !ProviderInterface)
     {
-        if (UGameViewportClient* GameViewportClient = LocalGameInstance->GetGameViewportClient())
+        UE_LOG(VSLog, Warning, TEXT("RegisterReadinessProvider called with an object that doesn't implement ILoadingScreenReadinessProvider."));
+        return;
+    }
+
+    const bool bAlreadyRegistered = ReadinessProviders.ContainsByPredicate([ProviderObject](const FReadinessProviderEntry& Entry)
+    {
+        return Entry.Object == ProviderObject;
+    });
+
+    if (bAlreadyRegistered)
+    {
+        return;
+    }
+
+    FReadinessProviderEntry NewEntry;
+    NewEntry.Object = ProviderObject;
+    NewEntry.Interface = ProviderInterface;
+    NewEntry.Priority = ProviderInterface->GetReadinessPriority();
+    NewEntry.bIsPush = ProviderInterface->GetReadinessMode() == ELoadingScreenReadinessMode::Push;
+
+    // Kept sorted so evaluation can stop at the first blocking provider. Equal priorities keep their registration order.
+    int32 InsertIndex = 0;
+    while (InsertIndex < ReadinessProviders.Num() && ReadinessProviders[InsertIndex].Priority >= NewEntry.Priority)
+    {
+        ++InsertIndex;
+    }
+
+    ReadinessProviders.Insert(MoveTemp(NewEntry), InsertIndex);
+}
+
+void ULoadingScreenSubsystem::UnregisterReadinessProvider(TScriptInterface<ILoadingScreenReadinessProvider> Provider)
+{
+    const UObject* ProviderObject = Provider.GetObject();
+    ReadinessProviders.RemoveAll([ProviderObject](const FReadinessProviderEntry& Entry)
+    {
+        return Entry.Object == ProviderObject;
+    });
+}
+
+void ULoadingScreenSubsystem::NotifyReadinessChanged(TScriptInterface<ILoadingScreenReadinessProvider> Provider)
+{
+    const UObject* ProviderObject = Provider.GetObject();
+    for (FReadinessProviderEntry& Entry : ReadinessProviders)
+    {
+        if (Entry.Object == ProviderObject)
+        {
+            Entry.bNeedsQuery = true;
+            return;
+        }
+    }
+}
+
+void ULoadingScreenSubsystem::DumpPackageLoadReport(FOutputDevice& Ar, int32 TopN) const
+{
+    if (!PackageTracker.IsValid())
+    {
+        Ar.Log(TEXT("Package load tracking is disabled. Enable bTrackPackageLoads in the Loading Screen settings."));
+        return;
+    }
+
+    if (!LastPackageReport.IsValid())
+    {
+        Ar.Log(TEXT("No transition has finished since package load tracking started."));
+        return;
+    }
+
+    LastPackageReport->Dump(Ar, TopN);
+}
+
+void ULoadingScreenSubsystem::DumpMemoryReport(FOutputDevice& Ar) const
+{
+    if (!MemoryTracker.IsValid())
+    {
+        Ar.Log(TEXT("Transition memory tracking is disabled. Enable bTrackTransitionMemory in the Loading Screen settings."));
+        return;
+    }
+
+    MemoryTracker->Dump(Ar);
+}
+
+void ULoadingScreenSubsystem::DumpSyncLoadReport(FOutputDevice& Ar) const
+{
+    if (!SyncLoadTracker.IsValid())
+    {
+        Ar.Log(TEXT("Sync load tracking is disabled. Enable bTrackSyncLoadsOutsideLoadingScreen in the Loading Screen settings."));
+        return;
+    }
+
+    SyncLoadTracker->Dump(Ar);
+}
+
+void ULoadingScreenSubsystem::DumpSlateReport(FOutputDevice& Ar) const
+{
+    if (SlateStatsPerWrapping.IsEmpty())
+    {
+        Ar.Log(TEXT("The full loading screen hasn't been displayed yet."));
+        return;
+    }
+
+    // Unwrapped is the baseline the panels are compared against
+    const FSlateFrameStats* BaselineStats = SlateStatsPerWrapping.Find(ELoadingScreenWidgetWrapping::None);
+    const double BaselineSecs = BaselineStats ? BaselineStats->GetAverageSecs() : 0.0;
+
+    Ar.Log(TEXT("Slate tick and paint time per frame while the loading screen was up, per widget wrapping. Change WidgetWrapping between transitions to compare."));
+    for (const TPair<ELoadingScreenWidgetWrapping, FSlateFrameStats>& WrappingPair : SlateStatsPerWrapping)
+    {
+        const FSlateFrameStats& Stats = WrappingPair.Value;
+        FString Comparison;
+        if (BaselineSecs > 0.0 && WrappingPair.Key != ELoadingScreenWidgetWrapping::None)
+        {
+            Comparison = FString::Printf(TEXT(", %+.0f%% against no wrapping"), (Stats.GetAverageSecs() - BaselineSecs) / BaselineSecs * 100.0);
+        }
+
+        Ar.Logf(TEXT("  %s: average %.2f ms, peak %.2f ms over %d frames%s"), *UEnum::GetDisplayValueAsText(WrappingPair.Key).ToString(),
+            Stats.GetAverageSecs() * 1000.0, Stats.PeakSecs * 1000.0, Stats.NumFrames, *Comparison);
+    }
+}
+
+void ULoadingScreenSubsystem::DumpLoadHistory(FOutputDevice& Ar) const
+{
+    if (!LoadHistory.IsValid())
+    {
+        Ar.Log(TEXT("Tiered presentation is disabled. Enable bUseTieredPresentation in the Loading Screen settings."));
+        return;
+    }
+
+    LoadHistory->Dump(Ar);
+}
+
+void ULoadingScreenSubsystem::DumpResidencyReport(FOutputDevice& Ar) const
+{
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+
+    Ar.Logf(TEXT("Loading screen widget '%s', residency policy %s, currently %s."), *Settings->LoadingScreenWidget.ToString(),
+        *UEnum::GetDisplayValueAsText(Settings->WidgetResidencyPolicy).ToString(), Settings->LoadingScreenWidget.ResolveClass() ? TEXT("loaded") : TEXT("not loaded"));
+
+    if (WidgetFootprintBytes < 0)
+    {
+        Ar.Log(TEXT("The widget hasn't been loaded yet, show the loading screen or call PreloadLoadingScreenAssets to measure it."));
+        return;
+    }
+
+    const double FootprintMB = WidgetFootprintBytes / (1024.0 * 1024.0);
+    Ar.Logf(TEXT("Footprint: %.2f MB in %d packages, including assets shared with anything else loaded at the time. Last load took %.3f s (%s)."),
+        FootprintMB, WidgetFootprintPackages, WidgetLoadSecs, bWidgetLoadWasSynchronous ? TEXT("synchronous") : TEXT("async"));
+
+    Ar.Logf(TEXT("  AlwaysResident: %.2f MB held during gameplay, nothing loaded when shown."), FootprintMB);
+    Ar.Logf(TEXT("  PreloadOnTravelIntent: %.2f MB held from the travel prediction until hidden, nothing held during gameplay otherwise. Blocks for what's left of the async load if shown before it finishes."), FootprintMB);
+    Ar.Logf(TEXT("  LoadOnDemand: nothing held during gameplay, blocks the game thread for a synchronous load each time it's shown after being collected."));
+}
+
+void ULoadingScreenSubsystem::HandlePreLoadMap(const FWorldContext& WorldContext, const FString& MapName)
+{
+    bIsInLoadMap = true;
+
+    // The transition map is only the first half of the travel, everything is attributed to the destination
+    const bool bIsLoadingTransitionMap = TravelState == ELoadingScreenTravelState::LoadingTransitionMap;
+    const FString DestinationMapName = bIsLoadingTransitionMap ? PendingTravelMap : MapName;
+
+    LoadMapName = DestinationMapName;
+
+    if (TravelIntentTimestamp > 0.0)
+    {
+        UE_LOG(VSLog, Log, TEXT("Loading screen for '%s' went up %.1f ms (%llu frames) before LoadMap, on travel intent."), *DestinationMapName,
+            (FPlatformTime::Seconds() - TravelIntentTimestamp) * 1000.0, GFrameCounter - TravelIntentFrame);
+        TravelIntentTimestamp = -1.0;
+    }
+
+    // Shown ahead of the load, e.g. by TravelWithPreload. The transition is named after where it ends up.
+    if (TransitionTimeline.IsActive())
+    {
+        TransitionTimeline.MapName = DestinationMapName;
+    }
+
+    // From here on the engine's own load keeps the screen up
+    if (!bIsLoadingTransitionMap)
+    {
+        TravelState = ELoadingScreenTravelState::None;
+    }
+
+    // Has to happen before LoadMap garbage collects the outgoing world
+    RetainSharedAssets(WorldContext, DestinationMapName);
+
+    // Arm before the blocking load starts, the watchdog is what tells us where LoadMap spends its time
+    ArmStallWatchdog(DestinationMapName);
+
+    BeginPackageTracking(DestinationMapName);
+
+    // The transition is a load in its own right, even if the screen isn't up yet
+    if (SyncLoadTracker.IsValid())
+    {
+        SyncLoadTracker->SetCoveredByLoadingScreen(true);
+    }
+
+    // Immediately update the loading screen once to initialize logic.
+    if (GEngine->IsInitialized())
+    {
+        UpdateLoadingScreen();
+    }
+
+    // After the update, which starts the transition if the screen wasn't already up
+    if (MemoryTracker.IsValid())
+    {
+        MemoryTracker->Sample(ELoadingScreenMemoryPoint::PreLoadMap);
+    }
+}
+
+void ULoadingScreenSubsystem::HandlePostLoadMap(UWorld* World)
+{
+    bIsInLoadMap = false;
+
+    // LoadMap has taken ownership of the world if it was the one we preloaded
+    PreloadedWorld = nullptr;
+    ResetTravelIntent();
+
+    if (MemoryTracker.IsValid())
+    {
+        MemoryTracker->Sample(ELoadingScreenMemoryPoint::PostLoadMap);
+    }
+
+    // Arrived in the transition map, the destination can now load while this world ticks
+    if (TravelState == ELoadingScreenTravelState::LoadingTransitionMap)
+    {
+        StartTravelPreload();
+    }
+
+    if (SyncLoadTracker.IsValid() && World)
+    {
+        SyncLoadTracker->SetCurrentMap(World->GetOutermost()->GetName());
+    }
+}
+
+void ULoadingScreenSubsystem::HandleTravelFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ErrorString)
+{
+    // The engine's fallback travel is picked up as a new intent on the next update
+    if (!IntendedTravelMap.IsEmpty() || TravelIntentTimestamp > 0.0)
+    {
+        UE_LOG(VSLog, Warning, TEXT("Intended travel failed: %s"), *ErrorString);
+        ResetTravelIntent();
+    }
+
+    if (TravelState == ELoadingScreenTravelState::None)
+    {
+        return;
+    }
+
+    // The engine falls back to its default map on its own, don't keep the screen up for a travel that will never happen
+    UE_LOG(VSLog, Warning, TEXT("Travel to '%s' failed: %s"), *PendingTravelMap, *ErrorString);
+    TravelState = ELoadingScreenTravelState::None;
+    PreloadedWorld = nullptr;
+}
+
+void ULoadingScreenSubsystem::HandleTravelPreloadCompleted(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+{
+    // Deinitialized, or the travel was cancelled while loading
+    if (TravelState != ELoadingScreenTravelState::PreloadingDestination)
+    {
+        return;
+    }
+
+    if (Result == EAsyncLoadingResult::Succeeded && LoadedPackage)
+    {
+        PreloadedWorld = UWorld::FindWorldInPackage(LoadedPackage);
+    }
+    else
+    {
+        // LoadMap will report the actual error, there's nothing more useful we can do here
+        UE_LOG(VSLog, Warning, TEXT("Preloading '%s' before travel failed, travelling anyway."), *PackageName.ToString());
+    }
+
+    IssuePendingTravel();
+}
+
+void ULoadingScreenSubsystem::StartTravelPreload()
+{
+    TravelState = ELoadingScreenTravelState::PreloadingDestination;
+
+    if (!FPackageName::IsValidLongPackageName(PendingTravelMap))
+    {
+        IssuePendingTravel();
+        return;
+    }
+
+    // Restarting the current map would hold on to the outgoing world, which LoadMap requires to be collected
+    if (FindPackage(nullptr, *PendingTravelMap))
+    {
+        IssuePendingTravel();
+        return;
+    }
+
+    LoadPackageAsync(PendingTravelMap, FLoadPackageAsyncDelegate::CreateUObject(this, &ThisClass::HandleTravelPreloadCompleted), 0, PKG_ContainsMap);
+}
+
+void ULoadingScreenSubsystem::IssuePendingTravel()
+{
+    UWorld* World = GetGameInstance()->GetWorld();
+    if (!World)
+    {
+        UE_LOG(VSLog, Error, TEXT("Could not travel to '%s', the game instance has no world."), *PendingTravelMap);
+        TravelState = ELoadingScreenTravelState::None;
+        PreloadedWorld = nullptr;
+        return;
+    }
+
+    // Same URL format as UGameplayStatics::OpenLevel
+    FString TravelURL = PendingTravelMap;
+    if (!PendingTravelOptions.IsEmpty())
+    {
+        TravelURL += PendingTravelOptions.StartsWith(TEXT("?")) ? PendingTravelOptions : FString(TEXT("?")) + PendingTravelOptions;
+    }
+
+    TravelState = ELoadingScreenTravelState::WaitingForLoadMap;
+    GEngine->SetClientTravel(World, *TravelURL, TRAVEL_Absolute);
+}
+
+void ULoadingScreenSubsystem::HandleGameFeatureLoadComplete(const FString& PluginName, const FString& Error)
+{
+    if (!Error.IsEmpty())
+    {
+        UE_LOG(VSLog, Error, TEXT("Game Feature plugin '%s' failed to load and activate: %s"), *PluginName, *Error);
+    }
+
+    PendingGameFeaturePlugins.Remove(PluginName);
+}
+
+void ULoadingScreenSubsystem::HandleMenuTransitionLoaded(int32 RequestId)
+{
+    const int32 Index = PendingMenuTransitions.IndexOfByPredicate([RequestId](const FMenuTransitionRequest& Request)
+    {
+        return Request.RequestId == RequestId;
+    });
+
+    // Deinitialized while loading
+    if (Index == INDEX_NONE)
+    {
+        return;
+    }
+
+    FMenuTransitionRequest Request = MoveTemp(PendingMenuTransitions[Index]);
+    PendingMenuTransitions.RemoveAt(Index);
+
+    UUserWidget* MenuWidget = nullptr;
+    if (UClass* WidgetClass = Request.WidgetClass.Get())
+    {
+        // Constructed here rather than by the caller, so that it happens behind the loading screen if it's up
+        if (APlayerController* OwningPlayer = Request.OwningPlayer.Get())
+        {
+            MenuWidget = CreateWidget<UUserWidget>(OwningPlayer, WidgetClass);
+        }
+        else
+        {
+            MenuWidget = CreateWidget<UUserWidget>(GetGameInstance(), WidgetClass);
+        }
+    }
+
+    if (MenuWidget)
+    {
+        UE_LOG(VSLog, Log, TEXT("Menu '%s' loaded and constructed in %.3f s%s."), *Request.WidgetClass.ToString(), FPlatformTime::Seconds() - Request.StartTime,
+            bIsDisplayingLoadingScreen ? TEXT(" behind the loading screen") : TEXT(""));
+    }
+    else
+    {
+        UE_LOG(VSLog, Error, TEXT("Failed to load the menu widget '%s'."), *Request.WidgetClass.ToString());
+    }
+
+    if (Request.Handle.IsValid())
+    {
+        if (MenuWidget)
+        {
+            MenuAssetHandles.Emplace(MenuWidget, Request.Handle);
+        }
+        else
+        {
+            Request.Handle->ReleaseHandle();
+        }
+    }
+
+    Request.OnComplete.ExecuteIfBound(MenuWidget);
+}
+
+bool ULoadingScreenSubsystem::CheckForDisplayReason()
+{
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+
+    // Forced in settings. Show loading screen!
+    if (Settings->bForceDisplayLoadingScreen == true)
+    {
+        LoadingScreenStateReason = FString(TEXT("ForceDisplayLoadingScreen in settings is true"));
+        DisplayPhase = ELoadingScreenPhase::Forced;
+        return true;
+    }
+
+    // The engine is loading a map. Show loading screen!
+    if (bIsInLoadMap)
+    {
+        LoadingScreenStateReason = FString(TEXT("Currently in LoadMap"));
+        DisplayPhase = ELoadingScreenPhase::LoadingMap;
+        return true;
+    }
+
+    // A travel we started hasn't reached LoadMap yet. Show loading screen!
+    if (TravelState == ELoadingScreenTravelState::LoadingTransitionMap)
+    {
+        LoadingScreenStateReason = FString::Printf(TEXT("Travelling to the transition map on the way to '%s'"), *PendingTravelMap);
+        DisplayPhase = ELoadingScreenPhase::WaitingForTravel;
+        return true;
+    }
+    else if (TravelState == ELoadingScreenTravelState::PreloadingDestination)
+    {
+        LoadingScreenStateReason = FString::Printf(TEXT("Preloading '%s' before travel"), *PendingTravelMap);
+        DisplayPhase = ELoadingScreenPhase::PreloadingTravel;
+        return true;
+    }
+    else if (TravelState == ELoadingScreenTravelState::WaitingForLoadMap)
+    {
+        LoadingScreenStateReason = FString::Printf(TEXT("Waiting for the engine to start travelling to '%s'"), *PendingTravelMap);
+        DisplayPhase = ELoadingScreenPhase::WaitingForTravel;
+        return true;
+    }
+
+    const UGameInstance* LocalGameInstance = GetGameInstance();
+
+    // No world context, probably no level. Show loading screen!
+    const FWorldContext* Context = LocalGameInstance->GetWorldContext();
+    if (!Context)
+    {
+        LoadingScreenStateReason = FString(TEXT("The game instance has a null WorldContext"));
+        DisplayPhase = ELoadingScreenPhase::WaitingForWorld;
+        return true;
+    }
+
+    // Travel has been requested, but the engine hasn't started loading the map yet. Show loading screen!
+    if (IsWaitingForIntendedTravel(*Context))
+    {
+        DisplayPhase = ELoadingScreenPhase::WaitingForTravel;
+        return true;
+    }
+
+	// No world, show loading screen!
+    UWorld* World = Context->World();
+    if (World == nullptr)
+    {
+        LoadingScreenStateReason = FString(TEXT("We have no world is null, FWorldContext's World()"));
+        DisplayPhase = ELoadingScreenPhase::WaitingForWorld;
+        return true;
+    }
+
+	// World isnt ready, show loading screen!
+    if (!World->HasBegunPlay())
+    {
+        LoadingScreenStateReason = FString(TEXT("World hasn't begun play"));
+        DisplayPhase = ELoadingScreenPhase::WaitingForWorld;
+        return true;
+    }
+
+    // The area around the player hasn't streamed in yet, show loading screen!
+    if (IsWaitingForWorldPartition(World))
+    {
+        DisplayPhase = ELoadingScreenPhase::WorldPartitionStreaming;
+        return true;
+    }
+
+    // Sublevels are still loading, show loading screen!
+    if (IsWaitingForStreamingLevels(World))
+    {
+        DisplayPhase = ELoadingScreenPhase::StreamingLevels;
+        return true;
+    }
+
+    // The local player or the initial replication hasn't arrived yet, show loading screen!
+    if (IsWaitingForNetworkReadiness(World))
+    {
+        DisplayPhase = ELoadingScreenPhase::NetworkReplication;
+        return true;
+    }
+
+    // Game Feature plugins are still loading or activating, show loading screen!
+    if (!PendingGameFeaturePlugins.IsEmpty())
+    {
+        LoadingScreenStateReason = FString::Printf(TEXT("Waiting for %d Game Feature plugins to load and activate"), PendingGameFeaturePlugins.Num());
+        DisplayPhase = ELoadingScreenPhase::GameFeatures;
+        return true;
+    }
+
+    // A menu is taking too long to load to open without a hitch, show loading screen!
+    if (IsWaitingForMenuTransition())
+    {
+        DisplayPhase = ELoadingScreenPhase::MenuTransition;
+        return true;
+    }
+
+    // A registered provider isn't ready yet, show loading screen!
+    if (IsWaitingForReadinessProviders())
+    {
+        DisplayPhase = ELoadingScreenPhase::ReadinessProviders;
+        return true;
+    }
+
+    // Game logic has requested the loading screen, show it!
+    if (bIsDisplayedByGameLogic == true)
+    {
+        if (UserSpecifiedLoadingScreenReason.IsEmpty())
+        {
+		    LoadingScreenStateReason = FString(TEXT("Reason not specified in ForceDisplayStateByGameLogic. Assumed gameplay logic."));
+        }
+        else
+        {
+            LoadingScreenStateReason = UserSpecifiedLoadingScreenReason;
+        }
+
+        DisplayPhase = ELoadingScreenPhase::GameLogic;
+		return true;
+    }
+
+    // No checks returned true, no reason to show
+    LoadingScreenStateReason = FString(TEXT("No reason to display."));
+    DisplayPhase = ELoadingScreenPhase::None;
+    return false;
+}
+
+void ULoadingScreenSubsystem::UpdateLoadingScreen()
+{
+    if (ApplyVisibilityHysteresis(ShouldShowLoadingScreen()))
+    {
+		ShowLoadingScreen();
+	}
+    else
+    {
+        HideLoadingScreen();
+    }
+
+    if (bIsDisplayingLoadingScreen)
+    {
+        TransitionTimeline.EnterPhase(DisplayPhase);
+        UpdatePresentationTier();
+    }
+
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+    
+    if (Settings->bLogLoadingScreenReason == true)
+    {
+        UE_LOG(VSLog, Log, TEXT("Loading screen display status: %d. Reason: %s"), bIsDisplayingLoadingScreen ? 1 : 0, *LoadingScreenStateReason);
+    }
+
+    PublishStateSnapshot();
+}
+
+void ULoadingScreenSubsystem::PublishStateSnapshot()
+{
+    FLoadingScreenStateSnapshot Snapshot;
+    Snapshot.bIsVisible = bIsDisplayingLoadingScreen;
+    Snapshot.Phase = GetCurrentPhase();
+
+    if (bIsDisplayingLoadingScreen)
+    {
+        Snapshot.NumActiveRequests = PendingGameFeaturePlugins.Num();
+        Snapshot.NumActiveRequests += PendingMenuTransitions.Num();
+        Snapshot.NumActiveRequests += bIsDisplayedByGameLogic ? 1 : 0;
+        Snapshot.NumActiveRequests += TravelState != ELoadingScreenTravelState::None ? 1 : 0;
+        Snapshot.NumActiveRequests += DisplayPhase == ELoadingScreenPhase::ReadinessProviders ? 1 : 0;
+
+        // Only the preload and the hold know how far along they are
+        Snapshot.Progress = -1.0f;
+        if (IsWaitingForAdditionalTime())
+        {
+            const float HoldTime = GetDefault<ULoadingScreenSettings>()->HoldLoadingScreenAdditionalSecs;
+            Snapshot.HoldTimeRemaining = FMath::Max(GetAdditionalTimeRemaining(), 0.0f);
+            Snapshot.Progress = HoldTime > 0.0f ? 1.0f - Snapshot.HoldTimeRemaining / HoldTime : 1.0f;
+        }
+        else if (TravelState == ELoadingScreenTravelState::PreloadingDestination)
+        {
+            const float LoadPercentage = GetAsyncLoadPercentage(FName(*PendingTravelMap));
+            if (LoadPercentage >= 0.0f)
+            {
+                Snapshot.Progress = LoadPercentage / 100.0f;
+            }
+        }
+    }
+
+    GLoadingScreenStatePublisher.Publish(Snapshot);
+}
+
+bool ULoadingScreenSubsystem::ApplyVisibilityHysteresis(bool bWantsToShow)
+{
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+    const double CurrentTime = FPlatformTime::Seconds();
+
+    if (bIsDisplayingLoadingScreen)
+    {
+        if (bWantsToShow)
+        {
+            // A reason came back before we got around to hiding, one session instead of two
+            if (PendingHideTimestamp >= 0.0)
+            {
+                ++NumFlapsPrevented;
+                ++NumFlapsPreventedThisSession;
+                PendingHideTimestamp = -1.0;
+            }
+            return true;
+        }
+
+        if (PendingHideTimestamp < 0.0)
+        {
+            PendingHideTimestamp = CurrentTime;
+        }
+
+        const double TimeDisplayed = CurrentTime - LoadingScreenShownTimestamp;
+        const double TimeWantingToHide = CurrentTime - PendingHideTimestamp;
+        if (TimeDisplayed >= Settings->MinimumDisplaySecs && TimeWantingToHide >= Settings->CoalescingWindowSecs)
+        {
+            PendingHideTimestamp = -1.0;
+            return false;
+        }
+
+        LoadingScreenStateReason = FString::Printf(TEXT("Keeping loading screen up for the minimum display time and coalescing window (%.2f seconds displayed)"), TimeDisplayed);
+        DisplayPhase = ELoadingScreenPhase::VisibilityHysteresis;
+        return true;
+    }
+
+    if (!bWantsToShow)
+    {
+        // The request went away while it was deferred, the screen never had to come up
+        if (PendingShowTimestamp >= 0.0)
+        {
+            ++NumFlapsPrevented;
+            PendingShowTimestamp = -1.0;
+        }
+        return false;
+    }
+
+    // Loads and missing worlds have to be covered no matter how recently the screen was hidden
+    const bool bCanBeDeferred = DisplayPhase == ELoadingScreenPhase::GameFeatures || DisplayPhase == ELoadingScreenPhase::MenuTransition
+        || DisplayPhase == ELoadingScreenPhase::ReadinessProviders || DisplayPhase == ELoadingScreenPhase::GameLogic;
+    const bool bMinimumHiddenTimeElapsed = LoadingScreenHiddenTimestamp < 0.0 || CurrentTime - LoadingScreenHiddenTimestamp >= Settings->MinimumHiddenSecs;
+
+    if (!bCanBeDeferred || bMinimumHiddenTimeElapsed)
+    {
+        PendingShowTimestamp = -1.0;
+        return true;
+    }
+
+    if (PendingShowTimestamp < 0.0)
+    {
+        PendingShowTimestamp = CurrentTime;
+    }
+
+    LoadingScreenStateReason = FString::Printf(TEXT("Deferring loading screen for the minimum hidden time: %s"), *LoadingScreenStateReason);
+    return false;
+}
+
+bool ULoadingScreenSubsystem::ShouldShowLoadingScreen()
+{
+    bool bNeedToShowLoadingScreen = CheckForDisplayReason();
+
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+
+    // Loading screen can be forced on bc of minimum on-times or other requirements.
+    bool bForcedToShowLoadingScreen = false;
+    if (bNeedToShowLoadingScreen)
+    {
+        // Still need to show it for other reasons, dont update
+        LoadingScreenLastDismissedTimestamp = -1.0;
+    }
+    else
+    {
+        const double CurrentTime = FPlatformTime::Seconds();
+        double HoldLoadingScreenTime = Settings->HoldLoadingScreenAdditionalSecs;
+
+        // If in editor and with waiting turned off, skip the additional time entirely
+        if (GIsEditor && Settings->bShowLoadingScreenAdditionalSecsInEditor == false)
+        {
+            HoldLoadingScreenTime = 0.0;
+        }
+
+        // Menus have no world streaming in behind the screen
+        const bool bOnlyCoveredMenus = !TransitionTimeline.Spans.IsEmpty() && !TransitionTimeline.Spans.ContainsByPredicate([](const FLoadingScreenPhaseSpan& Span)
+        {
+            return Span.Phase != ELoadingScreenPhase::MenuTransition && Span.Phase != ELoadingScreenPhase::AdditionalHold
+                && Span.Phase != ELoadingScreenPhase::VisibilityHysteresis;
+        });
+        if (bOnlyCoveredMenus)
+        {
+            HoldLoadingScreenTime = 0.0;
+        }
+
+        // Setup the timestamp the first time this is hit
+        if (LoadingScreenLastDismissedTimestamp < 0.0)
+        {
+            LoadingScreenLastDismissedTimestamp = CurrentTime;
+            OnHoldTimeTriggeredDelegate.Broadcast(HoldLoadingScreenTime);
+        }
+        const double TimeSinceScreenDismissed = CurrentTime - LoadingScreenLastDismissedTimestamp;
+
+        // Hold for an extra X seconds, to cover up geometry loading
+        if ((HoldLoadingScreenTime > 0.0) && (TimeSinceScreenDismissed < HoldLoadingScreenTime))
+        {
+            UGameViewportClient* GameViewportClient = GetGameInstance()->GetGameViewportClient();
+
+            // Prime streaming from the spawn viewpoint instead of rendering, up until the final moments before the reveal
+            const double HoldTimeRemaining = HoldLoadingScreenTime - TimeSinceScreenDismissed;
+            // Short loads don't cover the world, it has to keep rendering
+            const bool bPrimeWithoutRendering = Settings->bPrimeTextureStreamingWithoutRendering && HoldTimeRemaining > Settings->StreamingPrimingRenderLeadSecs
+                && PresentationTier == ELoadingScreenPresentationTier::Full;
+
+            if (bPrimeWithoutRendering && PrimeTextureStreaming())
+            {
+                GameViewportClient->bDisableWorldRendering = true;
+            }
+            else
+            {
+                // Make sure we're rendering the world at this point, so that textures will actually stream in
+                GameViewportClient->bDisableWorldRendering = false;
+            }
+
+            LoadingScreenStateReason = FString::Printf(TEXT("Keeping loading screen up for an additional %.2f seconds to allow texture streaming"), Settings->HoldLoadingScreenAdditionalSecs);
+            DisplayPhase = ELoadingScreenPhase::AdditionalHold;
+            bForcedToShowLoadingScreen = true;
+        }
+    }
+
+    return bNeedToShowLoadingScreen || bForcedToShowLoadingScreen;
+}
+
+void ULoadingScreenSubsystem::ShowLoadingScreen()
+{
+    // Already onscreen
+    if (bIsDisplayingLoadingScreen)
+    {
+        return;
+    }
+    
+    bIsDisplayingLoadingScreen = true;
+    LoadingScreenShownTimestamp = FPlatformTime::Seconds();
+    SessionSlateStats = FSlateFrameStats();
+
+    // Shown again before the previous ramp finished, there's nothing to ramp up behind the screen
+    EndQualityRamp();
+    NumFlapsPreventedThisSession = 0;
+
+    OnVisibilityChangedDelegate.Broadcast(bIsDisplayingLoadingScreen);
+
+    UGameInstance* LocalGameInstance = GetGameInstance();
+
+    if (SyncLoadTracker.IsValid())
+    {
+        SyncLoadTracker->SetCoveredByLoadingScreen(true);
+    }
+
+    // Shown ahead of a travel we know the destination of, or by game logic, in which case the transition is attributed to the current map
+    const bool bIsTravelling = bIsInLoadMap || TravelState != ELoadingScreenTravelState::None || !IntendedTravelMap.IsEmpty();
+    FString TransitionMapName = LoadMapName;
+    if (!bIsInLoadMap)
+    {
+        if (TravelState != ELoadingScreenTravelState::None)
+        {
+            TransitionMapName = PendingTravelMap;
+        }
+        else if (!IntendedTravelMap.IsEmpty())
+        {
+            TransitionMapName = IntendedTravelMap;
+        }
+        else
+        {
+            const UWorld* World = LocalGameInstance->GetWorld();
+            TransitionMapName = World ? World->GetOutermost()->GetName() : FString();
+        }
+    }
+
+    TransitionTimeline.Begin(TransitionMapName);
+    BeginPackageTracking(TransitionMapName);
+
+    if (MemoryTracker.IsValid())
+    {
+        MemoryTracker->BeginTransition();
+    }
+
+    if (TickThrottler.IsValid())
+    {
+        TickThrottler->BeginThrottling();
+    }
+
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+
+    // Game logic sessions aren't loads, there is nothing to predict them from
+    PredictedLoadSecs = -1.0f;
+    PresentationTier = bIsTravelling ? ChoosePresentationTier(TransitionMapName) : ELoadingScreenPresentationTier::Full;
+
+    // Otherwise the indicator is added by UpdatePresentationTier once its delay has passed
+    if (PresentationTier == ELoadingScreenPresentationTier::Full || (PresentationTier == ELoadingScreenPresentationTier::Indicator && Settings->ShortLoadIndicatorDelaySecs <= 0.0f))
+    {
+        AddLoadingScreenWidget(PresentationTier);
+        bIsAwaitingFirstPaint = true;
+    }
+
+    ChangePerformanceSettings(true);
+
+    // Nothing covers the world during short loads, a black viewport would be the very flash the tier avoids
+    if (PresentationTier != ELoadingScreenPresentationTier::Full)
+    {
+        LocalGameInstance->GetGameViewportClient()->bDisableWorldRendering = false;
+    }
+
+    if (!GIsEditor && LoadingScreenWidget.IsValid())
+    {
+        // Tick Slate to make sure the loading screen is displayed immediately
+        FSlateApplication::Get().Tick();
+    }
+}
+
+void ULoadingScreenSubsystem::HideLoadingScreen()
+{
+    // Already offscreen
+    if (!bIsDisplayingLoadingScreen)
+    {
+        return;
+    }
+
+    RemoveWidget();
+    bIsAwaitingFirstPaint = false;
+    SlateFrameStartTime = -1.0;
+
+    ChangePerformanceSettings(false);
+
+    WorldPartitionWaitStartTimestamp = -1.0;
+    StreamingLevelsWaitStartTimestamp = -1.0;
+    NetworkReadinessWaitStartTimestamp = -1.0;
+    NetworkActorCount = -1;
+
+    TransitionTimeline.End();
+    UE_LOG(VSLog, Log, TEXT("Loading screen transition to %s"), *TransitionTimeline.ToString());
+
+    // Only map loads go into the history, game logic sessions would skew it
+    const bool bLoadedMap = TransitionTimeline.Spans.ContainsByPredicate([](const FLoadingScreenPhaseSpan& Span)
+    {
+        return Span.Phase == ELoadingScreenPhase::LoadingMap;
+    });
+    if (LoadHistory.IsValid() && bLoadedMap)
+    {
+        // The hold is a fixed setting rather than part of the load
+        const float LoadSecs = TransitionTimeline.GetDuration() - TransitionTimeline.GetPhaseDuration(ELoadingScreenPhase::AdditionalHold);
+        const FString TierName = UEnum::GetDisplayValueAsText(PresentationTier).ToString();
+
+        if (PredictedLoadSecs >= 0.0f)
+        {
+            UE_LOG(VSLog, Log, TEXT("Presented '%s' as %s. Predicted %.3f s, took %.3f s (%+.0f%%)."), *TransitionTimeline.MapName, *TierName, PredictedLoadSecs, LoadSecs,
+                PredictedLoadSecs > 0.0f ? (LoadSecs - PredictedLoadSecs) / PredictedLoadSecs * 100.0f : 0.0f);
+        }
+        else
+        {
+            UE_LOG(VSLog, Log, TEXT("Presented '%s' as %s without a prediction, took %.3f s."), *TransitionTimeline.MapName, *TierName, LoadSecs);
+        }
+
+        LoadHistory->Record(UWorld::RemovePIEPrefix(TransitionTimeline.MapName), LoadSecs);
+    }
+
+    // The indicator is too small to say anything about the wrapping
+    if (SessionSlateStats.NumFrames > 0 && PresentationTier == ELoadingScreenPresentationTier::Full)
+    {
+        UE_LOG(VSLog, Log, TEXT("Slate took %.2f ms per frame on average, %.2f ms at most, over %d frames with %s wrapping."), SessionSlateStats.GetAverageSecs() * 1000.0,
+            SessionSlateStats.PeakSecs * 1000.0, SessionSlateStats.NumFrames, *UEnum::GetDisplayValueAsText(SessionWidgetWrapping).ToString());
+
+        FSlateFrameStats& WrappingStats = SlateStatsPerWrapping.FindOrAdd(SessionWidgetWrapping);
+        WrappingStats.NumFrames += SessionSlateStats.NumFrames;
+        WrappingStats.TotalSecs += SessionSlateStats.TotalSecs;
+        WrappingStats.PeakSecs = FMath::Max(WrappingStats.PeakSecs, SessionSlateStats.PeakSecs);
+    }
+
+    if (NumFlapsPreventedThisSession > 0)
+    {
+        UE_LOG(VSLog, Log, TEXT("Coalesced %d requests into this loading screen instead of hiding and showing it again."), NumFlapsPreventedThisSession);
+    }
+
+    if (TickThrottler.IsValid())
+    {
+        TickThrottler->EndThrottling(TransitionTimeline.MapName);
+    }
+
+    if (MemoryTracker.IsValid())
+    {
+        MemoryTracker->EndTransition(TransitionTimeline.MapName);
+    }
+
+    DisarmStallWatchdog();
+
+    EndPackageTracking();
+
+    // After the package report, which goes into the bundle
+    CheckLoadBudget();
+
+    ReleaseRetainedAssets();
+
+    if (SyncLoadTracker.IsValid())
+    {
+        SyncLoadTracker->SetCoveredByLoadingScreen(false);
+    }
+
+    bIsDisplayingLoadingScreen = false;
+    LoadingScreenHiddenTimestamp = FPlatformTime::Seconds();
+
+    BeginQualityRamp();
+
+    OnVisibilityChangedDelegate.Broadcast(bIsDisplayingLoadingScreen);
+}
+
+void ULoadingScreenSubsystem::AddLoadingScreenWidget(ELoadingScreenPresentationTier Tier)
+{
+    LLM_SCOPE_BYTAG(LoadingScreen);
+
+    UGameInstance* LocalGameInstance = GetGameInstance();
+    UGameViewportClient* GameViewportClient = LocalGameInstance->GetGameViewportClient();
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+
+    // Replacing the indicator of a short load that turned out to be long
+    if (LoadingScreenWidget.IsValid())
+    {
+        GameViewportClient->RemoveViewportWidgetContent(LoadingScreenWidget.ToSharedRef());
+        LoadingScreenWidget.Reset();
+    }
+
+    SessionWidgetWrapping = ELoadingScreenWidgetWrapping::None;
+
+    if (Tier == ELoadingScreenPresentationTier::Indicator)
+    {
+        LoadingScreenWidget = SNew(SBox)
+            .HAlign(HAlign_Right)
+            .VAlign(VAlign_Bottom)
+            .Padding(FMargin(48.0f))
+            [
+                SNew(SThrobber)
+            ];
+    }
+    else
+    {
+        TSubclassOf<UUserWidget> LoadingScreenWidgetClass = LoadWidgetClass();
+        if (UUserWidget* UserWidget = UUserWidget::CreateWidgetInstance(*LocalGameInstance, LoadingScreenWidgetClass, NAME_None))
+        {
+            LoadingScreenWidget = WrapLoadingScreenWidget(UserWidget->TakeWidget());
+        }
+        else
+        {
+            UE_LOG(VSLog, Error, TEXT("Failed to load the loading screen widget '%s', falling back to placeholder."), *Settings->LoadingScreenWidget.ToString());
+            LoadingScreenWidget = SNew(SThrobber);
+        }
+    }
+
+    // Add to the viewport at a high ZOrder to make sure it is on top of most things
+    GameViewportClient->AddViewportWidgetContent(LoadingScreenWidget.ToSharedRef(), Settings->ZOrder);
+}
+
+TSharedRef<SWidget> ULoadingScreenSubsystem::WrapLoadingScreenWidget(const TSharedRef<SWidget>& Content)
+{
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+    SessionWidgetWrapping = Settings->WidgetWrapping;
+
+    if (Settings->WidgetWrapping == ELoadingScreenWidgetWrapping::InvalidationPanel)
+    {
+        // Widgets that animate are volatile and still repaint every frame, everything else is drawn from the cache
+        return SNew(SInvalidationPanel)
+            [
+                Content
+            ];
+    }
+
+    if (Settings->WidgetWrapping == ELoadingScreenWidgetWrapping::RetainerPanel)
+    {
+        return SNew(SRetainerWidget)
+            .RenderOnPhase(true)
+            .RenderOnInvalidation(false)
+            .Phase(0)
+            .PhaseCount(FMath::Max(Settings->RetainedRenderPhaseCount, 1))
+            [
+                Content
+            ];
+    }
+
+    return Content;
+}
+
+ELoadingScreenPresentationTier ULoadingScreenSubsystem::ChoosePresentationTier(const FString& MapName)
+{
+    PredictedLoadSecs = -1.0f;
+    if (!LoadHistory.IsValid())
+    {
+        return ELoadingScreenPresentationTier::Full;
+    }
+
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+    PredictedLoadSecs = LoadHistory->Predict(UWorld::RemovePIEPrefix(MapName));
+
+    // Never loaded before, or known to be long
+    if (PredictedLoadSecs < 0.0f || PredictedLoadSecs >= Settings->ShortLoadThresholdSecs)
+    {
+        return ELoadingScreenPresentationTier::Full;
+    }
+
+    return Settings->bShowIndicatorForShortLoads ? ELoadingScreenPresentationTier::Indicator : ELoadingScreenPresentationTier::None;
+}
+
+void ULoadingScreenSubsystem::UpdatePresentationTier()
+{
+    if (PresentationTier == ELoadingScreenPresentationTier::Full)
+    {
+        return;
+    }
+
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+    const double TimeDisplayed = FPlatformTime::Seconds() - LoadingScreenShownTimestamp;
+
+    // Still loading past the threshold, the prediction was wrong. The holds don't count, they aren't loading.
+    if (DisplayPhase != ELoadingScreenPhase::AdditionalHold && DisplayPhase != ELoadingScreenPhase::VisibilityHysteresis && TimeDisplayed > Settings->ShortLoadThresholdSecs)
+    {
+        UE_LOG(VSLog, Log, TEXT("Loading '%s' was predicted to take %.3f s but is still going after %.3f s, switching to the full loading screen."),
+            *TransitionTimeline.MapName, PredictedLoadSecs, TimeDisplayed);
+
+        PresentationTier = ELoadingScreenPresentationTier::Full;
+        AddLoadingScreenWidget(PresentationTier);
+        GetGameInstance()->GetGameViewportClient()->bDisableWorldRendering = true;
+        return;
+    }
+
+    if (PresentationTier == ELoadingScreenPresentationTier::Indicator && !LoadingScreenWidget.IsValid() && TimeDisplayed >= Settings->ShortLoadIndicatorDelaySecs)
+    {
+        AddLoadingScreenWidget(PresentationTier);
+    }
+}
+
+void ULoadingScreenSubsystem::RemoveWidget()
+{
+    // Gets the widget if the sharedptr is valid, before resetting it and destroying the object
+    UGameInstance* LocalGameInstance = GetGameInstance();
+    if (LoadingScreenWidget.IsValid())
+    {
+        if (UGameViewportClient* GameViewportClient = LocalGameInstance->GetGameViewportClient())
+        {
+            GameViewportClient->RemoveViewportWidgetContent(LoadingScreenWidget.ToSharedRef());
+        }
+        LoadingScreenWidget.Reset();
+    }
+
+    // The widget instance was what kept its assets alive while displayed
+    if (GetDefault<ULoadingScreenSettings>()->WidgetResidencyPolicy != ELoadingScreenResidencyPolicy::AlwaysResident)
+    {
+        ReleaseWidgetAssets();
+    }
+}
+
+TSubclassOf<UUserWidget> ULoadingScreenSubsystem::LoadWidgetClass()
+{
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+
+    if (WidgetAssetsHandle.IsValid())
+    {
+        // Shown before the preload finished, what's left of it is still cheaper than starting over
+        if (WidgetAssetsHandle->IsLoadingInProgress())
+        {
+            WidgetAssetsHandle->WaitUntilComplete();
+        }
+
+        if (UClass* PreloadedClass = Cast<UClass>(WidgetAssetsHandle->GetLoadedAsset()))
+        {
+            return PreloadedClass;
+        }
+    }
+
+    // Not collected yet since the last time it was shown
+    if (UClass* ResidentClass = Settings->LoadingScreenWidget.ResolveClass())
+    {
+        return ResidentClass;
+    }
+
+    if (Settings->LoadingScreenWidget.IsNull())
+    {
+        return nullptr;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    TSubclassOf<UUserWidget> WidgetClass = Settings->LoadingScreenWidget.TryLoadClass<UUserWidget>();
+    if (WidgetClass)
+    {
+        RecordWidgetLoad(FPlatformTime::Seconds() - StartTime, true);
+    }
+
+    return WidgetClass;
+}
+
+void ULoadingScreenSubsystem::PrewarmWidget()
+{
+    LLM_SCOPE_BYTAG(LoadingScreen);
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    UGameInstance* LocalGameInstance = GetGameInstance();
+    UUserWidget* UserWidget = UUserWidget::CreateWidgetInstance(*LocalGameInstance, LoadWidgetClass(), NAME_None);
+    if (!UserWidget)
+    {
+        UE_LOG(VSLog, Warning, TEXT("Could not pre-warm the loading screen widget '%s', it failed to load."), *GetDefault<ULoadingScreenSettings>()->LoadingScreenWidget.ToString());
+        return;
+    }
+
+    // Drawn at the size it will be shown at, so that fonts are cached at the sizes they'll be used at
+    FVector2D DrawSize(1920.0, 1080.0);
+    if (UGameViewportClient* GameViewportClient = LocalGameInstance->GetGameViewportClient())
+    {
+        FVector2D ViewportSize;
+        GameViewportClient->GetViewportSize(ViewportSize);
+        if (ViewportSize.X > 0.0 && ViewportSize.Y > 0.0)
+        {
+            DrawSize = ViewportSize;
+        }
+    }
+
+    // The render target and widget are collected with the next garbage collection, the compiled shaders and cached glyphs stay
+    UTextureRenderTarget2D* RenderTarget = FWidgetRenderer::CreateTargetFor(DrawSize, TF_Bilinear, true);
+    FWidgetRenderer* WidgetRenderer = new FWidgetRenderer(true);
+    WidgetRenderer->DrawWidget(RenderTarget, UserWidget->TakeWidget(), DrawSize, 0.0f);
+
+    // The render thread may still be using it
+    BeginCleanup(WidgetRenderer);
+
+    bWasWidgetPrewarmed = true;
+    UE_LOG(VSLog, Log, TEXT("Pre-warmed the loading screen widget at %.0fx%.0f in %.1f ms."), DrawSize.X, DrawSize.Y, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void ULoadingScreenSubsystem::HandleSlatePreTick(float DeltaTime)
+{
+    SlateFrameStartTime = bIsDisplayingLoadingScreen && LoadingScreenWidget.IsValid() ? FPlatformTime::Seconds() : -1.0;
+}
+
+void ULoadingScreenSubsystem::HandleSlateWindowRendered(SWindow& Window, void* ViewportRHIPtr)
+{
+    if (!bIsDisplayingLoadingScreen)
+    {
+        return;
+    }
+
+    // Other windows, such as the editor's, may be painted in between
+    const UGameViewportClient* GameViewportClient = GetGameInstance()->GetGameViewportClient();
+    if (!GameViewportClient || GameViewportClient->GetWindow().Get() != &Window)
+    {
+        return;
+    }
+
+    if (SlateFrameStartTime > 0.0)
+    {
+        const double FrameSecs = FPlatformTime::Seconds() - SlateFrameStartTime;
+        SlateFrameStartTime = -1.0;
+
+        ++SessionSlateStats.NumFrames;
+        SessionSlateStats.TotalSecs += FrameSecs;
+        SessionSlateStats.PeakSecs = FMath::Max(SessionSlateStats.PeakSecs, FrameSecs);
+    }
+
+    if (!bIsAwaitingFirstPaint)
+    {
+        return;
+    }
+
+    bIsAwaitingFirstPaint = false;
+    LastTimeToFirstPaintSecs = static_cast<float>(FPlatformTime::Seconds() - LoadingScreenShownTimestamp);
+
+    UE_LOG(VSLog, Log, TEXT("First loading screen frame painted %.1f ms after it was shown (%s)."), LastTimeToFirstPaintSecs * 1000.0f,
+        bWasWidgetPrewarmed ? TEXT("pre-warmed") : TEXT("not pre-warmed"));
+}
+
+void ULoadingScreenSubsystem::ReleaseWidgetAssets()
+{
+    if (WidgetAssetsHandle.IsValid())
+    {
+        WidgetAssetsHandle->ReleaseHandle();
+        WidgetAssetsHandle.Reset();
+    }
+}
+
+void ULoadingScreenSubsystem::RecordWidgetLoad(double LoadSecs, bool bWasSynchronous)
+{
+    WidgetLoadSecs = LoadSecs;
+    bWidgetLoadWasSynchronous = bWasSynchronous;
+
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+    WidgetFootprintBytes = LoadingScreenPackageUtils::GetLoadedClosureSize(FName(*Settings->LoadingScreenWidget.GetLongPackageName()), &WidgetFootprintPackages);
+
+    UE_LOG(VSLog, Log, TEXT("Loaded the loading screen widget %s in %.3f s, %.2f MB in %d packages."), bWasSynchronous ? TEXT("synchronously") : TEXT("asynchronously"),
+        LoadSecs, WidgetFootprintBytes / (1024.0 * 1024.0), WidgetFootprintPackages);
+}
+
+void ULoadingScreenSubsystem::ChangePerformanceSettings(bool bEnabingLoadingScreen)
+{
+    UGameInstance* LocalGameInstance = GetGameInstance();
+    UGameViewportClient* GameViewportClient = LocalGameInstance->GetGameViewportClient();
+
+    // Could later look into changing the ShaderPipelineCaching to toggle between Fast and Background for even quicker loading.
+
+    // Don't bother drawing the 3D world while we're loading
+    GameViewportClient->bDisableWorldRendering = bEnabingLoadingScreen;
+
+    // Make sure to prioritize streaming in levels if the loading screen is up
+    if (UWorld* ViewportWorld = GameViewportClient->GetWorld())
+    {
+        if (AWorldSettings* WorldSettings = ViewportWorld->GetWorldSettings(false, false))
+        {
+            WorldSettings->bHighPriorityLoadingLocal = bEnabingLoadingScreen;
+        }
+    }
+
+    // Nobody sees the world while the screen is up, so streamed levels can be registered in as few and as long frames as needed
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+    if (bEnabingLoadingScreen && Settings->bWaitForStreamingLevels)
+    {
+        if (!LevelStreamingOverrides.IsValid())
+        {
+            LevelStreamingOverrides = MakeShared<FLoadingScreenCVarOverrides>();
+        }
+
+        const FString Granularity = FString::FromInt(Settings->StreamingLevelsRegistrationGranularity);
+        LevelStreamingOverrides->Override(TEXT("s.LevelStreamingComponentsRegistrationGranularity"), Granularity);
+        LevelStreamingOverrides->Override(TEXT("s.LevelStreamingComponentsUnregistrationGranularity"), Granularity);
+        LevelStreamingOverrides->Override(TEXT("s.LevelStreamingActorsUpdateGranularity"), Granularity);
+    }
+    else if (LevelStreamingOverrides.IsValid())
+    {
+        LevelStreamingOverrides->RestoreAll();
+    }
+}
+
+float ULoadingScreenSubsystem::GetLoadBudget(const FString& MapName) const
+{
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+
+    // PIE worlds carry the instance prefix, the budgets are set up for the original package
+    const FString OriginalMapName = UWorld::RemovePIEPrefix(MapName);
+    for (const TPair<TSoftObjectPtr<UWorld>, float>& MapBudget : Settings->MapLoadBudgets)
+    {
+        if (MapBudget.Key.GetLongPackageName() == OriginalMapName)
+        {
+            return MapBudget.Value;
+        }
+    }
+
+    return Settings->DefaultLoadBudgetSecs;
+}
+
+void ULoadingScreenSubsystem::CheckLoadBudget()
+{
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+    if (!Settings->bMonitorLoadBudgets)
+    {
+        return;
+    }
+
+    // Menu transitions and screens shown without a map load aren't map loads, so they have no budget
+    const bool bLoadedMap = TransitionTimeline.Spans.ContainsByPredicate([](const FLoadingScreenPhaseSpan& Span)
+    {
+        return Span.Phase == ELoadingScreenPhase::LoadingMap;
+    });
+
+    if (!bLoadedMap)
+    {
+        return;
+    }
+
+    // The additional hold is there on purpose, so it doesn't count against the budget
+    const FString& MapName = TransitionTimeline.MapName;
+    const float Budget = GetLoadBudget(MapName);
+    const double Duration = TransitionTimeline.GetDuration() - TransitionTimeline.GetPhaseDuration(ELoadingScreenPhase::AdditionalHold);
+    if (Budget <= 0.0f || Duration <= Budget)
+    {
+        return;
+    }
+
+    const FString BundleDirectory = LoadingScreenDiagnostics::MakeReportDirectoryPath(TEXT("SlowLoad"), MapName);
+    IFileManager::Get().MakeDirectory(*BundleDirectory, true);
+
+    UE_LOG(VSLog, Warning, TEXT("Transition to '%s' took %.2f seconds, over its budget of %.2f seconds. Writing diagnostics to '%s'."), *MapName, Duration, Budget, *BundleDirectory);
+
+    FString Summary;
+    Summary += FString::Printf(TEXT("Map: %s\n"), *MapName);
+    Summary += FString::Printf(TEXT("Duration: %.3f s\n"), Duration);
+    Summary += FString::Printf(TEXT("Budget: %.3f s\n\n"), Budget);
+
+    Summary += TEXT("Phases, in order:\n");
+    for (const FLoadingScreenPhaseSpan& Span : TransitionTimeline.Spans)
+    {
+        Summary += FString::Printf(TEXT("  %-24s %8.3f s  (from %.3f s)\n"), *UEnum::GetDisplayValueAsText(Span.Phase).ToString(), Span.GetDuration(), Span.StartTime - TransitionTimeline.StartTime);
+    }
+
+    // Sampled through the transition, the peak is usually where the outgoing and incoming worlds overlap
+    const FString TransitionMemory = MemoryTracker.IsValid() ? MemoryTracker->DescribeLatestTransition(MapName) : FString();
+    if (!TransitionMemory.IsEmpty())
+    {
+        Summary += TEXT("\nMemory during the transition, used physical (0 where the point wasn't reached):\n");
+        Summary += TransitionMemory;
+    }
+    else
+    {
+        Summary += TEXT("\nMemory during the transition: not recorded, enable bTrackTransitionMemory to include it.\n");
+    }
+
+    const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+    Summary += TEXT("\nMemory at reveal:\n");
+    Summary += FString::Printf(TEXT("  Used physical:      %.2f MB\n"), MemoryStats.UsedPhysical / (1024.0 * 1024.0));
+    Summary += FString::Printf(TEXT("  Peak used physical: %.2f MB\n"), MemoryStats.PeakUsedPhysical / (1024.0 * 1024.0));
+    Summary += FString::Printf(TEXT("  Available physical: %.2f MB\n"), MemoryStats.AvailablePhysical / (1024.0 * 1024.0));
+    Summary += FString::Printf(TEXT("  Used virtual:       %.2f MB\n"), MemoryStats.UsedVirtual / (1024.0 * 1024.0));
+
+    // The tracker records every transition and has just handed its report over, so this is the one that ended
+    if (PackageTracker.IsValid() && LastPackageReport.IsValid() && !LastPackageReport->IsEmpty())
+    {
+        LastPackageReport->SaveAsJson(BundleDirectory / TEXT("PackageLoads.json"), Settings->PackageLoadReportTopN);
+        Summary += FString::Printf(TEXT("\nPackages: %d loaded, %d sync, %.2f MB on disk. See PackageLoads.json.\n"),
+            LastPackageReport->Packages.Num(), LastPackageReport->NumSyncLoads, LastPackageReport->TotalDiskSize / (1024.0 * 1024.0));
+    }
+    else
+    {
+        Summary += TEXT("\nPackages: not recorded, enable bTrackPackageLoads to include them.\n");
+    }
+
+    if (Settings->bRunMemReportOnBudgetExceeded)
+    {
+        GEngine->Exec(GetGameInstance()->GetWorld(), TEXT("MemReport"));
+        Summary += TEXT("MemReport: written to Saved/Profiling/MemReports.\n");
+    }
+
+    if (Settings->bWriteTraceSnapshotOnBudgetExceeded)
+    {
+        const FString TracePath = BundleDirectory / TEXT("Transition.utrace");
+        const bool bWroteTrace = FTraceAuxiliary::WriteSnapshot(*TracePath);
+        Summary += bWroteTrace ? FString(TEXT("Trace: Transition.utrace\n")) : FString(TEXT("Trace: snapshot failed, is tracing running?\n"));
+    }
+
+    FFileHelper::SaveStringToFile(Summary, *(BundleDirectory / TEXT("Summary.txt")));
+}
+
+void ULoadingScreenSubsystem::BeginQualityRamp()
+{
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+    if (!Settings->bRampQualityAfterReveal || Settings->PostRevealStartScreenPercentage >= 100.0f)
+    {
+        return;
+    }
+
+    if (!QualityRampOverrides.IsValid())
+    {
+        QualityRampOverrides = MakeShared<FLoadingScreenCVarOverrides>();
+    }
+
+    // Zero or less means the engine picks the default, which is 100% of the render resolution
+    const float UserPercentage = FCString::Atof(*QualityRampOverrides->GetOriginalValue(TEXT("r.ScreenPercentage")));
+    QualityRampTargetPercentage = UserPercentage > 0.0f ? UserPercentage : 100.0f;
+
+    const float StartPercentage = FMath::RoundToFloat(QualityRampTargetPercentage * Settings->PostRevealStartScreenPercentage / 100.0f);
+    if (!QualityRampOverrides->Override(TEXT("r.ScreenPercentage"), FString::SanitizeFloat(StartPercentage)))
+    {
+        return;
+    }
+
+    QualityRampAppliedPercentage = StartPercentage;
+    QualityRampProgress = 0.0f;
+    QualityRampStartTimestamp = FPlatformTime::Seconds();
+}
+
+void ULoadingScreenSubsystem::UpdateQualityRamp()
+{
+    if (QualityRampProgress < 0.0f)
+    {
+        return;
+    }
+
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+
+    // Real frame time, not affected by time dilation or pausing
+    const double FrameTimeMs = FApp::GetDeltaTime() * 1000.0;
+    if (FrameTimeMs <= Settings->PostRevealTargetFrameTimeMs)
+    {
+        QualityRampProgress += Settings->PostRevealRampSecs > 0.0f ? FApp::GetDeltaTime() / Settings->PostRevealRampSecs : 1.0f;
+    }
+
+    const double TimeRamping = FPlatformTime::Seconds() - QualityRampStartTimestamp;
+    if (QualityRampProgress >= 1.0f || (Settings->PostRevealMaxRampSecs > 0.0f && TimeRamping >= Settings->PostRevealMaxRampSecs))
+    {
+        UE_LOG(VSLog, Log, TEXT("Post-reveal quality ramp finished after %.2f seconds."), TimeRamping);
+        EndQualityRamp();
+        return;
+    }
+
+    // Whole percentages, so the view isn't resized on every single frame
+    const float StartPercentage = QualityRampTargetPercentage * Settings->PostRevealStartScreenPercentage / 100.0f;
+    const float Percentage = FMath::RoundToFloat(FMath::Lerp(StartPercentage, QualityRampTargetPercentage, QualityRampProgress));
+    if (Percentage != QualityRampAppliedPercentage)
+    {
+        QualityRampOverrides->Override(TEXT("r.ScreenPercentage"), FString::SanitizeFloat(Percentage));
+        QualityRampAppliedPercentage = Percentage;
+    }
+}
+
+void ULoadingScreenSubsystem::EndQualityRamp()
+{
+    QualityRampProgress = -1.0f;
+
+    if (QualityRampOverrides.IsValid())
+    {
+        QualityRampOverrides->RestoreAll();
+    }
+}
+
+void ULoadingScreenSubsystem::ArmStallWatchdog(const FString& MapName)
+{
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+    if (!Settings->bEnableStallWatchdog)
+    {
+        return;
+    }
+
+    if (!StallWatchdog.IsValid())
+    {
+        StallWatchdog = MakeShared<FLoadingScreenStallWatchdog>();
+    }
+
+    StallWatchdog->Arm(MapName, Settings->StallWatchdogSampleIntervalMs, Settings->StallWatchdogMaxStackDepth, Settings->StallWatchdogStacksInReport);
+}
+
+void ULoadingScreenSubsystem::DisarmStallWatchdog()
+{
+    if (!StallWatchdog.IsValid())
+    {
+        return;
+    }
+
+    const FString ReportPath = StallWatchdog->Disarm();
+    if (!ReportPath.IsEmpty())
+    {
+        UE_LOG(VSLog, Log, TEXT("Loading screen stall watchdog disarmed, writing hot-stack report to '%s'."), *ReportPath);
+    }
+}
+
+void ULoadingScreenSubsystem::BeginPackageTracking(const FString& MapName)
+{
+    if (!PackageTracker.IsValid() || PackageTracker->IsTracking())
+    {
+        return;
+    }
+
+    PackageTracker->BeginTransition(MapName);
+}
+
+void ULoadingScreenSubsystem::EndPackageTracking()
+{
+    if (!PackageTracker.IsValid() || !PackageTracker->IsTracking())
+    {
+        return;
+    }
+
+    LastPackageReport = MakeShared<FLoadingScreenPackageReport>(PackageTracker->EndTransition());
+
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+    if (Settings->bWritePackageLoadReport && !LastPackageReport->IsEmpty())
+    {
+        const FString ReportPath = LoadingScreenDiagnostics::MakeReportPath(TEXT("PackageLoads"), LastPackageReport->MapName, TEXT("json"));
+        if (LastPackageReport->SaveAsJson(ReportPath, Settings->PackageLoadReportTopN))
+        {
+            UE_LOG(VSLog, Log, TEXT("Loading screen package report for '%s' written to '%s'."), *LastPackageReport->MapName, *ReportPath);
+        }
+        else
+        {
+            UE_LOG(VSLog, Warning, TEXT("Failed to write loading screen package report to '%s'."), *ReportPath);
+        }
+    }
+}
+
+bool ULoadingScreenSubsystem::IsWaitingForIntendedTravel(const FWorldContext& Context)
+{
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+    if (!Settings->bShowOnTravelIntent)
+    {
+        return false;
+    }
+
+    // Set by OpenLevel, ClientTravel and SetClientTravel, and consumed by the engine's next TickWorldTravel
+    const bool bHasTravelURL = !Context.TravelURL.IsEmpty();
+    const bool bIsConnecting = Context.PendingNetGame != nullptr;
+
+    if (!bHasTravelURL && !bIsConnecting)
+    {
+        // Cancelled before the engine got to it
+        ResetTravelIntent();
+        return false;
+    }
+
+    if (TravelIntentTimestamp < 0.0)
+    {
+        TravelIntentTimestamp = FPlatformTime::Seconds();
+        TravelIntentFrame = GFrameCounter;
+
+        PreloadLoadingScreenAssets();
+    }
+
+    if (!bHasTravelURL)
+    {
+        LoadingScreenStateReason = FString::Printf(TEXT("Connecting to '%s'"), *Context.PendingNetGame->URL.Host);
+        return true;
+    }
+
+    LoadingScreenStateReason = FString::Printf(TEXT("Travel to '%s' requested"), *Context.TravelURL);
+
+    // Relative travel such as ?restart or ?closed doesn't name its map, and short names would need a search on disk
+    const FURL TravelURL(nullptr, *Context.TravelURL, TRAVEL_Absolute);
+    const bool bCanPrefetch = Settings->bPrefetchDestinationOnTravelIntent && !GIsEditor && Context.TravelType != TRAVEL_Relative && !Context.TravelURL.StartsWith(TEXT("?"))
+        && TravelURL.Valid && TravelURL.IsLocalInternal() && FPackageName::IsValidLongPackageName(TravelURL.Map);
+
+    // Restarting the current map would hold on to the outgoing world, which LoadMap requires to be collected
+    if (bCanPrefetch && IntendedTravelMap.IsEmpty() && !FindPackage(nullptr, *TravelURL.Map))
+    {
+        IntendedTravelMap = TravelURL.Map;
+        LoadPackageAsync(IntendedTravelMap, FLoadPackageAsyncDelegate::CreateWeakLambda(this, [this](const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
         {
-            GameViewportClient->RemoveViewportWidgetContent(LoadingScreenWidget.ToSharedRef());
+            // The travel failed or already happened while this was loading
+            if (IntendedTravelMap.IsEmpty() || FName(*IntendedTravelMap) != PackageName)
+            {
+                return;
+            }
+
+            if (Result == EAsyncLoadingResult::Succeeded && LoadedPackage)
+            {
+                PreloadedWorld = UWorld::FindWorldInPackage(LoadedPackage);
+            }
+        }), 0, PKG_ContainsMap);
+    }
+
+    return true;
+}
+
+void ULoadingScreenSubsystem::ResetTravelIntent()
+{
+    if (!IntendedTravelMap.IsEmpty())
+    {
+        IntendedTravelMap.Reset();
+        PreloadedWorld = nullptr;
+    }
+
+    TravelIntentTimestamp = -1.0;
+}
+
+bool ULoadingScreenSubsystem::IsWaitingForMenuTransition()
+{
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+    const double CurrentTime = FPlatformTime::Seconds();
+
+    for (const FMenuTransitionRequest& Request : PendingMenuTransitions)
+    {
+        if (CurrentTime - Request.StartTime >= Settings->MenuTransitionLoadingScreenDelaySecs)
+        {
+            LoadingScreenStateReason = FString::Printf(TEXT("Loading menu '%s'"), *Request.WidgetClass.ToString());
+            return true;
         }
-        LoadingScreenWidget.Reset();
     }
+
+    return false;
 }
 
-void ULoadingScreenSubsystem::ChangePerformanceSettings(bool bEnabingLoadingScreen)
+bool ULoadingScreenSubsystem::IsWaitingForWorldPartition(UWorld* World)
+{
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+    if (!Settings->bWaitForWorldPartitionStreaming || !World->IsPartitionedWorld())
+    {
+        return false;
+    }
+
+    // Streaming around the player is continuous during gameplay, only keep an already displayed screen up
+    if (!bIsDisplayingLoadingScreen)
+    {
+        return false;
+    }
+
+    const double CurrentTime = FPlatformTime::Seconds();
+    if (WorldPartitionWaitStartTimestamp < 0.0)
+    {
+        WorldPartitionWaitStartTimestamp = CurrentTime;
+    }
+
+    // Already timed out during this loading screen
+    if (WorldPartitionWaitStartTimestamp == 0.0)
+    {
+        return false;
+    }
+
+    FString WaitReason;
+
+    if (const UWorldPartitionSubsystem* WorldPartitionSubsystem = World->GetSubsystem<UWorldPartitionSubsystem>())
+    {
+        // Covers every streaming source, the player's as well as any placed by game code
+        if (!WorldPartitionSubsystem->IsStreamingCompleted())
+        {
+            WaitReason = FString(TEXT("World Partition is streaming in the area around the streaming sources"));
+        }
+    }
+
+    if (WaitReason.IsEmpty())
+    {
+        if (const UDataLayerManager* DataLayerManager = UDataLayerManager::GetDataLayerManager(World))
+        {
+            for (const TSoftObjectPtr<UDataLayerAsset>& RequiredDataLayer : Settings->RequiredDataLayers)
+            {
+                // Data layers used by the map are loaded with it, anything not loaded isn't part of this map
+                const UDataLayerAsset* DataLayerAsset = RequiredDataLayer.Get();
+                const UDataLayerInstance* DataLayerInstance = DataLayerAsset ? DataLayerManager->GetDataLayerInstanceFromAsset(DataLayerAsset) : nullptr;
+                if (DataLayerInstance && DataLayerInstance->GetEffectiveRuntimeState() != EDataLayerRuntimeState::Activated)
+                {
+                    WaitReason = FString::Printf(TEXT("Waiting for data layer '%s' to be activated"), *DataLayerAsset->GetName());
+                    break;
+                }
+            }
+        }
+    }
+
+    if (WaitReason.IsEmpty())
+    {
+        return false;
+    }
+
+    const double TimeWaited = CurrentTime - WorldPartitionWaitStartTimestamp;
+    if (Settings->WorldPartitionStreamingTimeoutSecs > 0.0f && TimeWaited > Settings->WorldPartitionStreamingTimeoutSecs)
+    {
+        UE_LOG(VSLog, Warning, TEXT("Gave up waiting for World Partition after %.2f seconds: %s"), TimeWaited, *WaitReason);
+
+        // Marks the timeout until the screen is hidden
+        WorldPartitionWaitStartTimestamp = 0.0;
+        return false;
+    }
+
+    LoadingScreenStateReason = WaitReason;
+    return true;
+}
+
+bool ULoadingScreenSubsystem::IsWaitingForNetworkReadiness(UWorld* World)
+{
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+    if (!Settings->bWaitForNetworkReadiness || !bIsDisplayingLoadingScreen)
+    {
+        return false;
+    }
+
+    // Standalone and hosts have everything locally by begin play
+    if (World->GetNetMode() != NM_Client)
+    {
+        return false;
+    }
+
+    const double CurrentTime = FPlatformTime::Seconds();
+    if (NetworkReadinessWaitStartTimestamp < 0.0)
+    {
+        NetworkReadinessWaitStartTimestamp = CurrentTime;
+    }
+
+    // Already timed out during this loading screen
+    if (NetworkReadinessWaitStartTimestamp == 0.0)
+    {
+        return false;
+    }
+
+    FString WaitReason;
+
+    const APlayerController* PlayerController = GetGameInstance()->GetFirstLocalPlayerController(World);
+    if (!PlayerController)
+    {
+        WaitReason = FString(TEXT("Waiting for the local player controller"));
+    }
+    else if (!PlayerController->GetPawn())
+    {
+        WaitReason = FString(TEXT("Waiting for the local player controller to possess a pawn"));
+    }
+    else if (!PlayerController->PlayerState || !World->GetGameState())
+    {
+        WaitReason = FString(TEXT("Waiting for the game state and player state to replicate"));
+    }
+    else
+    {
+        // Replicated actors are spawned as their channels open, so a stable count means the initial burst is over.
+        // Only actors the server owns are counted, the ones spawned locally by begin play would reset the settle time for nothing.
+        int32 NumActors = 0;
+        for (const ULevel* Level : World->GetLevels())
+        {
+            if (!Level)
+            {
+                continue;
+            }
+
+            for (const AActor* Actor : Level->Actors)
+            {
+                if (Actor && Actor->GetIsReplicated() && Actor->GetLocalRole() != ROLE_Authority)
+                {
+                    ++NumActors;
+                }
+            }
+        }
+
+        if (NumActors != NetworkActorCount)
+        {
+            NetworkActorCount = NumActors;
+            NetworkActorCountChangedTimestamp = CurrentTime;
+        }
+
+        if (CurrentTime - NetworkActorCountChangedTimestamp < Settings->NetworkReplicationSettleSecs)
+        {
+            WaitReason = FString::Printf(TEXT("Waiting for initial replication to settle, %d replicated actors so far"), NumActors);
+        }
+    }
+
+    if (WaitReason.IsEmpty())
+    {
+        return false;
+    }
+
+    const double TimeWaited = CurrentTime - NetworkReadinessWaitStartTimestamp;
+    if (Settings->NetworkReadinessTimeoutSecs > 0.0f && TimeWaited > Settings->NetworkReadinessTimeoutSecs)
+    {
+        UE_LOG(VSLog, Warning, TEXT("Gave up waiting for network readiness after %.2f seconds: %s"), TimeWaited, *WaitReason);
+
+        // Marks the timeout until the screen is hidden
+        NetworkReadinessWaitStartTimestamp = 0.0;
+        return false;
+    }
+
+    LoadingScreenStateReason = WaitReason;
+    return true;
+}
+
+bool ULoadingScreenSubsystem::IsWaitingForReadinessProviders()
+{
+    bool bFoundStaleProvider = false;
+    const FReadinessProviderEntry* BlockingEntry = nullptr;
+
+    for (FReadinessProviderEntry& Entry : ReadinessProviders)
+    {
+        // Destroyed without unregistering
+        if (!Entry.Object.IsValid())
+        {
+            bFoundStaleProvider = true;
+            continue;
+        }
+
+        // Push providers that haven't notified us keep their last answer
+        if (!Entry.bIsPush || Entry.bNeedsQuery)
+        {
+            Entry.CachedReason.Reset();
+            Entry.bCachedBlocking = Entry.Interface->IsBlockingLoadingScreen(Entry.CachedReason);
+            Entry.bNeedsQuery = false;
+        }
+
+        // Sorted by priority, so nothing after this one can be reported
+        if (Entry.bCachedBlocking)
+        {
+            BlockingEntry = &Entry;
+            break;
+        }
+    }
+
+    if (BlockingEntry)
+    {
+        const FString ProviderName = BlockingEntry->Object->GetName();
+        if (BlockingEntry->CachedReason.IsEmpty())
+        {
+            LoadingScreenStateReason = FString::Printf(TEXT("Readiness provider '%s' is blocking. Reason not specified."), *ProviderName);
+        }
+        else
+        {
+            LoadingScreenStateReason = FString::Printf(TEXT("Readiness provider '%s' is blocking: %s"), *ProviderName, *BlockingEntry->CachedReason);
+        }
+    }
+
+    const bool bIsBlocking = BlockingEntry != nullptr;
+
+    // Done last, removing invalidates BlockingEntry
+    if (bFoundStaleProvider)
+    {
+        ReadinessProviders.RemoveAll([](const FReadinessProviderEntry& Entry)
+        {
+            return !Entry.Object.IsValid();
+        });
+    }
+
+    return bIsBlocking;
+}
+
+bool ULoadingScreenSubsystem::IsWaitingForStreamingLevels(UWorld* World)
+{
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+    if (!Settings->bWaitForStreamingLevels || !bIsDisplayingLoadingScreen)
+    {
+        return false;
+    }
+
+    // Already timed out during this loading screen
+    if (StreamingLevelsWaitStartTimestamp == 0.0)
+    {
+        return false;
+    }
+
+    int32 NumLoading = 0;
+    int32 NumPendingVisibility = 0;
+    for (const ULevelStreaming* StreamingLevel : World->GetStreamingLevels())
+    {
+        if (!StreamingLevel)
+        {
+            continue;
+        }
+
+        const ELevelStreamingState State = StreamingLevel->GetLevelStreamingState();
+        if (State == ELevelStreamingState::Loading || (StreamingLevel->ShouldBeLoaded() && State == ELevelStreamingState::Unloaded))
+        {
+            ++NumLoading;
+        }
+        else if (StreamingLevel->ShouldBeVisible() && !StreamingLevel->IsLevelVisible())
+        {
+            ++NumPendingVisibility;
+        }
+    }
+
+    if (NumLoading == 0)
+    {
+        // A later batch of levels gets the full timeout rather than what's left of this one
+        StreamingLevelsWaitStartTimestamp = -1.0;
+
+        // Everything is resident, so make the rest visible now in a single frame rather than one level at a time
+        if (NumPendingVisibility > 0)
+        {
+            const double FlushStartTime = FPlatformTime::Seconds();
+            World->FlushLevelStreaming(EFlushLevelStreamingType::Visibility);
+            UE_LOG(VSLog, Log, TEXT("Made %d streaming levels visible behind the loading screen in %.2f ms."), NumPendingVisibility, (FPlatformTime::Seconds() - FlushStartTime) * 1000.0);
+        }
+
+        return false;
+    }
+
+    const double CurrentTime = FPlatformTime::Seconds();
+    if (StreamingLevelsWaitStartTimestamp < 0.0)
+    {
+        StreamingLevelsWaitStartTimestamp = CurrentTime;
+    }
+
+    const double TimeWaited = CurrentTime - StreamingLevelsWaitStartTimestamp;
+    if (Settings->StreamingLevelsTimeoutSecs > 0.0f && TimeWaited > Settings->StreamingLevelsTimeoutSecs)
+    {
+        UE_LOG(VSLog, Warning, TEXT("Gave up waiting for %d streaming levels after %.2f seconds."), NumLoading, TimeWaited);
+
+        // Marks the timeout until the screen is hidden
+        StreamingLevelsWaitStartTimestamp = 0.0;
+        return false;
+    }
+
+    LoadingScreenStateReason = FString::Printf(TEXT("Waiting for %d streaming levels to load"), NumLoading);
+    return true;
+}
+
+bool ULoadingScreenSubsystem::PrimeTextureStreaming()
 {
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+
     UGameInstance* LocalGameInstance = GetGameInstance();
-    UGameViewportClient* GameViewportClient = LocalGameInstance->GetGameViewportClient();
+    UWorld* World = LocalGameInstance->GetWorld();
+    if (!World)
+    {
+        return false;
+    }
 
-    // Could later look into changing the ShaderPipelineCaching to toggle between Fast and Background for even quicker loading.
+    FVector ViewLocation = FVector::ZeroVector;
+    float FOV = Settings->StreamingPrimingDefaultFOV;
+    bool bFoundViewpoint = false;
 
-    // Don't bother drawing the 3D world while we're loading
-    GameViewportClient->bDisableWorldRendering = bEnabingLoadingScreen;
+    // Prefer the camera of the possessed pawn, it's exactly what will be revealed
+    if (APlayerController* PlayerController = LocalGameInstance->GetFirstLocalPlayerController(World))
+    {
+        if (PlayerController->GetPawn() && PlayerController->PlayerCameraManager)
+        {
+            FRotator ViewRotation;
+            PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+            FOV = PlayerController->PlayerCameraManager->GetFOVAngle();
+            bFoundViewpoint = true;
+        }
+    }
 
-    // Make sure to prioritize streaming in levels if the loading screen is up
-    if (UWorld* ViewportWorld = GameViewportClient->GetWorld())
+    // Not possessed yet, the player will most likely spawn at a player start
+    if (!bFoundViewpoint)
     {
-        if (AWorldSettings* WorldSettings = ViewportWorld->GetWorldSettings(false, false))
+        for (TActorIterator<APlayerStart> It(World); It; ++It)
         {
-            WorldSettings->bHighPriorityLoadingLocal = bEnabingLoadingScreen;
+            ViewLocation = It->GetActorLocation();
+            bFoundViewpoint = true;
+            break;
+        }
+    }
+
+    if (!bFoundViewpoint)
+    {
+        return false;
+    }
+
+    FVector2D ViewportSize(1920.0, 1080.0);
+    if (UGameViewportClient* GameViewportClient = LocalGameInstance->GetGameViewportClient())
+    {
+        GameViewportClient->GetViewportSize(ViewportSize);
+    }
+
+    // Same screen size terms the renderer uses when it registers its views with the streamer
+    const float ScreenSize = FMath::Max(ViewportSize.X, 1.0);
+    const float FOVScreenSize = ScreenSize / FMath::Tan(FMath::DegreesToRadians(FMath::Clamp(FOV, 5.0f, 170.0f) * 0.5f));
+
+    IStreamingManager::Get().AddViewInformation(ViewLocation, ScreenSize, FOVScreenSize);
+    return true;
+}
+
+void ULoadingScreenSubsystem::RetainSharedAssets(const FWorldContext& WorldContext, const FString& MapName)
+{
+    const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+    if (!Settings->bRetainSharedAssetsAcrossTransitions || !WorldContext.World())
+    {
+        return;
+    }
+
+    LLM_SCOPE_BYTAG(LoadingScreen);
+
+    ReleaseRetainedAssets();
+
+    // PIE travel URLs carry the instance prefix, the asset registry only knows the original package
+    const FName DestinationPackage(*UWorld::RemovePIEPrefix(MapName));
+
+    TSet<FName> DestinationClosure;
+    LoadingScreenPackageUtils::GetDependencyClosure(DestinationPackage, DestinationClosure);
+
+    // Only the map itself, so there's nothing to compare against
+    if (DestinationClosure.Num() <= 1)
+    {
+        if (FPackageName::DoesPackageExist(DestinationPackage.ToString()))
+        {
+            UE_LOG(VSLog, Warning, TEXT("No dependencies known for '%s', not retaining any assets. Packaged builds need bSerializeDependencies=true under [AssetRegistry]."), *DestinationPackage.ToString());
+        }
+        return;
+    }
+
+    struct FCandidate
+    {
+        TArray<UObject*> Assets;
+        int64 EstimatedSize = 0;
+    };
+
+    TArray<FCandidate> Candidates;
+    for (const FName PackageName : DestinationClosure)
+    {
+        UPackage* Package = FindObjectFast<UPackage>(nullptr, PackageName);
+        if (!Package || !Package->IsFullyLoaded())
+        {
+            continue;
+        }
+
+        // Map data belongs to a world, and LoadMap requires the outgoing world to be fully collected
+        if (Package->ContainsMap() || Package->HasAnyPackageFlags(PKG_ContainsMapData))
+        {
+            continue;
+        }
+
+        FCandidate Candidate;
+        ForEachObjectWithPackage(Package, [&Candidate](UObject* Object)
+        {
+            if (Object->IsAsset())
+            {
+                Candidate.Assets.Add(Object);
+                Candidate.EstimatedSize += Object->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+            }
+            return true;
+        }, false);
+
+        if (!Candidate.Assets.IsEmpty())
+        {
+            Candidates.Add(MoveTemp(Candidate));
+        }
+    }
+
+    // Keep the largest assets first, those are the ones that cost the most to load again
+    Candidates.Sort([](const FCandidate& A, const FCandidate& B)
+    {
+        return A.EstimatedSize > B.EstimatedSize;
+    });
+
+    const int64 MemoryCap = static_cast<int64>(Settings->RetainedAssetsMemoryCapMB) * 1024 * 1024;
+    int64 RetainedSize = 0;
+    int32 NumRetainedPackages = 0;
+    int32 NumSkippedPackages = 0;
+
+    for (const FCandidate& Candidate : Candidates)
+    {
+        if (RetainedSize + Candidate.EstimatedSize > MemoryCap)
+        {
+            ++NumSkippedPackages;
+            continue;
         }
+
+        RetainedSize += Candidate.EstimatedSize;
+        ++NumRetainedPackages;
+        RetainedAssets.Append(Candidate.Assets);
     }
+
+    UE_LOG(VSLog, Log, TEXT("Retaining %d packages (%.2f MB) shared with '%s' across the transition, %d packages skipped by the memory cap."),
+        NumRetainedPackages, RetainedSize / (1024.0 * 1024.0), *MapName, NumSkippedPackages);
+}
+
+void ULoadingScreenSubsystem::ReleaseRetainedAssets()
+{
+    // Collected by the next regular garbage collection if the new world doesn't use them after all
+    RetainedAssets.Reset();
 }
@@ -0,0 +1,286 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+
+#include "LoadingScreenSyncLoadTracker.h"
+
+#include "HAL/PlatformStackWalk.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/OutputDevice.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+#include "LoadingScreenPackageUtils.h"
+
+#include "DevCommons.h"
+
+namespace LoadingScreenSyncLoadTracker
+{
+    // Frames belonging to the stack walker and the loading delegates, which are the same for every capture.
+    static constexpr uint32 IgnoredFrames = 4;
+    static constexpr uint32 MaxCapturedFrames = 32;
+}
+
+FLoadingScreenSyncLoadTracker::FLoadingScreenSyncLoadTracker(bool bInCaptureCallstacks, float InMinDurationMs, bool bInLogEachLoad)
+    : bCaptureCallstacks(bInCaptureCallstacks)
+    , bLogEachLoad(bInLogEachLoad)
+    , MinDurationSecs(FMath::Max(InMinDurationMs, 0.0f) / 1000.0)
+{
+    SyncLoadHandle = FCoreDelegates::OnSyncLoadPackage.AddRaw(this, &FLoadingScreenSyncLoadTracker::HandleSyncLoadPackage);
+    EndLoadHandle = FCoreUObjectDelegates::OnEndLoadPackage.AddRaw(this, &FLoadingScreenSyncLoadTracker::HandleEndLoadPackage);
+    FlushHandle = FCoreDelegates::OnAsyncLoadingFlush.AddRaw(this, &FLoadingScreenSyncLoadTracker::HandleAsyncLoadingFlush);
+}
+
+FLoadingScreenSyncLoadTracker::~FLoadingScreenSyncLoadTracker()
+{
+    FCoreDelegates::OnSyncLoadPackage.Remove(SyncLoadHandle);
+    FCoreUObjectDelegates::OnEndLoadPackage.Remove(EndLoadHandle);
+    FCoreDelegates::OnAsyncLoadingFlush.Remove(FlushHandle);
+}
+
+void FLoadingScreenSyncLoadTracker::SetCoveredByLoadingScreen(bool bCovered)
+{
+    bIsCoveredByLoadingScreen = bCovered;
+
+    // Anything in flight belongs to the transition now
+    PendingLoads.Reset();
+}
+
+void FLoadingScreenSyncLoadTracker::SetCurrentMap(const FString& MapName)
+{
+    CurrentMapName = MapName;
+}
+
+void FLoadingScreenSyncLoadTracker::Tick()
+{
+    // Loads of packages that failed, or were otherwise never finished, don't get an end event
+    PendingLoads.Reset();
+}
+
+void FLoadingScreenSyncLoadTracker::Dump(FOutputDevice& Ar) const
+{
+    if (MapStats.IsEmpty())
+    {
+        Ar.Log(TEXT("No synchronous loads or flushes have been recorded outside the loading screen."));
+        return;
+    }
+
+    for (const TPair<FString, FMapStats>& MapPair : MapStats)
+    {
+        const FMapStats& Stats = MapPair.Value;
+        Ar.Logf(TEXT("Map '%s': %d sync loads outside the loading screen, %.2f ms total."), *MapPair.Key, Stats.Count, Stats.TotalSecs * 1000.0);
+
+        if (Stats.FlushCount > 0)
+        {
+            Ar.Logf(TEXT("  %d async loading flushes (not timed)"), Stats.FlushCount);
+            if (Stats.LastFlushStackHash != 0)
+            {
+                Ar.Log(DescribeCallstack(Stats.LastFlushStackHash));
+            }
+        }
+
+        TArray<FName> SortedNames;
+        Stats.Hitches.GenerateKeyArray(SortedNames);
+        SortedNames.Sort([&Stats](const FName& A, const FName& B)
+        {
+            return Stats.Hitches[A].TotalSecs > Stats.Hitches[B].TotalSecs;
+        });
+
+        for (const FName& Name : SortedNames)
+        {
+            const FHitchStats& Hitch = Stats.Hitches[Name];
+            Ar.Logf(TEXT("  %8.2f ms total, %8.2f ms worst, %3dx  %s"), Hitch.TotalSecs * 1000.0, Hitch.MaxSecs * 1000.0, Hitch.Count, *Name.ToString());
+
+            if (Hitch.WorstStackHash != 0)
+            {
+                Ar.Log(DescribeCallstack(Hitch.WorstStackHash));
+            }
+        }
+    }
+}
+
+bool FLoadingScreenSyncLoadTracker::SaveAsJson(const FString& Path) const
+{
+    if (MapStats.IsEmpty())
+    {
+        return false;
+    }
+
+    FString JsonString;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+
+    Writer->WriteArrayStart();
+    for (const TPair<FString, FMapStats>& MapPair : MapStats)
+    {
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("map"), MapPair.Key);
+        Writer->WriteValue(TEXT("count"), MapPair.Value.Count);
+        Writer->WriteValue(TEXT("totalSecs"), MapPair.Value.TotalSecs);
+        Writer->WriteValue(TEXT("flushes"), MapPair.Value.FlushCount);
+
+        Writer->WriteArrayStart(TEXT("loads"));
+        for (const TPair<FName, FHitchStats>& HitchPair : MapPair.Value.Hitches)
+        {
+            Writer->WriteObjectStart();
+            Writer->WriteValue(TEXT("package"), HitchPair.Key.ToString());
+            Writer->WriteValue(TEXT("count"), HitchPair.Value.Count);
+            Writer->WriteValue(TEXT("totalSecs"), HitchPair.Value.TotalSecs);
+            Writer->WriteValue(TEXT("maxSecs"), HitchPair.Value.MaxSecs);
+            if (HitchPair.Value.WorstStackHash != 0)
+            {
+                Writer->WriteValue(TEXT("callstack"), DescribeCallstack(HitchPair.Value.WorstStackHash));
+            }
+            Writer->WriteObjectEnd();
+        }
+        Writer->WriteArrayEnd();
+
+        Writer->WriteObjectEnd();
+    }
+    Writer->WriteArrayEnd();
+    Writer->Close();
+
+    return FFileHelper::SaveStringToFile(JsonString, *Path);
+}
+
+void FLoadingScreenSyncLoadTracker::HandleSyncLoadPackage(const FString& PackageName)
+{
+    if (!IsRecording())
+    {
+        return;
+    }
+
+    const FName LongPackageName = LoadingScreenPackageUtils::ToPackageName(PackageName);
+    if (PendingLoads.Contains(LongPackageName))
+    {
+        return;
+    }
+
+    // Loading a package that's already loaded returns immediately and never gets an end event
+    const UPackage* ExistingPackage = FindPackage(nullptr, *LongPackageName.ToString());
+    if (ExistingPackage && ExistingPackage->IsFullyLoaded())
+    {
+        return;
+    }
+
+    FPendingLoad& PendingLoad = PendingLoads.Add(LongPackageName);
+    PendingLoad.StackHash = CaptureCallstack();
+
+    // Started last, so that capturing the callstack isn't counted as part of the load
+    PendingLoad.StartTime = FPlatformTime::Seconds();
+}
+
+void FLoadingScreenSyncLoadTracker::HandleEndLoadPackage(const FEndLoadPackageContext& Context)
+{
+    if (!IsRecording() || PendingLoads.IsEmpty())
+    {
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+
+    for (const UPackage* Package : Context.LoadedPackages)
+    {
+        FPendingLoad PendingLoad;
+        if (Package && PendingLoads.RemoveAndCopyValue(Package->GetFName(), PendingLoad))
+        {
+            RecordHitch(Package->GetFName(), Now - PendingLoad.StartTime, PendingLoad.StackHash);
+        }
+    }
+}
+
+void FLoadingScreenSyncLoadTracker::HandleAsyncLoadingFlush()
+{
+    // Every sync load flushes async loading too, which is already recorded as the load itself
+    if (!IsRecording() || !PendingLoads.IsEmpty())
+    {
+        return;
+    }
+
+    // There's no end event to time the flush against, so it's only counted
+    FMapStats& Stats = MapStats.FindOrAdd(CurrentMapName.IsEmpty() ? FString(TEXT("NoMap")) : CurrentMapName);
+    ++Stats.FlushCount;
+
+    const uint32 StackHash = CaptureCallstack();
+    if (StackHash != 0)
+    {
+        Stats.LastFlushStackHash = StackHash;
+    }
+
+    if (bLogEachLoad)
+    {
+        UE_LOG(VSLog, Warning, TEXT("Async loading was flushed outside the loading screen in map '%s'."), *CurrentMapName);
+    }
+}
+
+uint32 FLoadingScreenSyncLoadTracker::CaptureCallstack()
+{
+    if (!bCaptureCallstacks)
+    {
+        return 0;
+    }
+
+    uint64 BackTrace[LoadingScreenSyncLoadTracker::MaxCapturedFrames + LoadingScreenSyncLoadTracker::IgnoredFrames] = {};
+    const uint32 Depth = FPlatformStackWalk::CaptureStackBackTrace(BackTrace, UE_ARRAY_COUNT(BackTrace));
+    if (Depth <= LoadingScreenSyncLoadTracker::IgnoredFrames)
+    {
+        return 0;
+    }
+
+    const uint64* CallerFrames = BackTrace + LoadingScreenSyncLoadTracker::IgnoredFrames;
+    const uint32 NumCallerFrames = Depth - LoadingScreenSyncLoadTracker::IgnoredFrames;
+    const uint32 StackHash = FCrc::MemCrc32(CallerFrames, NumCallerFrames * sizeof(uint64));
+
+    if (!Callstacks.Contains(StackHash))
+    {
+        Callstacks.Add(StackHash, TArray<uint64>(CallerFrames, NumCallerFrames));
+    }
+
+    return StackHash;
+}
+
+void FLoadingScreenSyncLoadTracker::RecordHitch(FName Name, double DurationSecs, uint32 StackHash)
+{
+    if (DurationSecs < MinDurationSecs)
+    {
+        return;
+    }
+
+    FMapStats& Stats = MapStats.FindOrAdd(CurrentMapName.IsEmpty() ? FString(TEXT("NoMap")) : CurrentMapName);
+    ++Stats.Count;
+    Stats.TotalSecs += DurationSecs;
+
+    FHitchStats& Hitch = Stats.Hitches.FindOrAdd(Name);
+    ++Hitch.Count;
+    Hitch.TotalSecs += DurationSecs;
+    if (DurationSecs > Hitch.MaxSecs)
+    {
+        Hitch.MaxSecs = DurationSecs;
+        Hitch.WorstStackHash = StackHash;
+    }
+
+    if (bLogEachLoad)
+    {
+        UE_LOG(VSLog, Warning, TEXT("%s took %.2f ms outside the loading screen in map '%s'."), *Name.ToString(), DurationSecs * 1000.0, *CurrentMapName);
+    }
+}
+
+FString FLoadingScreenSyncLoadTracker::DescribeCallstack(uint32 StackHash) const
+{
+    const TArray<uint64>* Frames = Callstacks.Find(StackHash);
+    if (!Frames)
+    {
+        return FString();
+    }
+
+    FString Description;
+    for (const uint64 ProgramCounter : *Frames)
+    {
+        FProgramCounterSymbolInfo SymbolInfo;
+        FPlatformStackWalk::ProgramCounterToSymbolInfo(ProgramCounter, SymbolInfo);
+        Description += FString::Printf(TEXT("        %s [%s:%d]\n"), ANSI_TO_TCHAR(SymbolInfo.FunctionName), ANSI_TO_TCHAR(SymbolInfo.Filename), SymbolInfo.LineNumber);
+    }
+
+    return Description;
+}
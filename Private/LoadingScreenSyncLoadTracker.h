@@ -0,0 +1,100 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FOutputDevice;
+struct FEndLoadPackageContext;
+
+/*
+* Flags synchronous package loads and async loading flushes that happen while the loading screen is down.
+* These are gameplay hitches the loading screen doesn't cover. They are aggregated per map, so that the
+* offending loads can be moved under the next loading screen or made asynchronous.
+*/
+class FLoadingScreenSyncLoadTracker
+{
+public:
+	FLoadingScreenSyncLoadTracker(bool bInCaptureCallstacks, float InMinDurationMs, bool bInLogEachLoad);
+	~FLoadingScreenSyncLoadTracker();
+
+	// Stops recording while a transition is covered by the loading screen, and resumes when it's revealed.
+	void SetCoveredByLoadingScreen(bool bCovered);
+
+	// The map that new hitches are attributed to.
+	void SetCurrentMap(const FString& MapName);
+
+	// Drops sync loads that never got an end event, such as failed loads. Called once per frame from the game thread.
+	void Tick();
+
+	// Prints the aggregated hitches per map, most expensive first.
+	void Dump(FOutputDevice& Ar) const;
+
+	// Writes the aggregated hitches as JSON. Returns false if nothing was recorded or the file couldn't be written.
+	bool SaveAsJson(const FString& Path) const;
+
+	bool HasRecordedHitches() const { return !MapStats.IsEmpty(); }
+
+private:
+	// A package that hitched gameplay.
+	struct FHitchStats
+	{
+		int32 Count = 0;
+		double TotalSecs = 0.0;
+		double MaxSecs = 0.0;
+
+		// The callstack of the most expensive occurrence, if callstacks are captured.
+		uint32 WorstStackHash = 0;
+	};
+
+	struct FMapStats
+	{
+		int32 Count = 0;
+		double TotalSecs = 0.0;
+		TMap<FName, FHitchStats> Hitches;
+
+		// Flushes have no end event, so they're counted rather than timed.
+		int32 FlushCount = 0;
+		uint32 LastFlushStackHash = 0;
+	};
+
+	void HandleSyncLoadPackage(const FString& PackageName);
+	void HandleEndLoadPackage(const FEndLoadPackageContext& Context);
+	void HandleAsyncLoadingFlush();
+
+	// Captures the calling context, returning the hash of the stored stack or 0 if callstacks are disabled.
+	uint32 CaptureCallstack();
+
+	void RecordHitch(FName Name, double DurationSecs, uint32 StackHash);
+
+	// Symbolicates a stored callstack, one frame per line.
+	FString DescribeCallstack(uint32 StackHash) const;
+
+	bool IsRecording() const { return !bIsCoveredByLoadingScreen && IsInGameThread(); }
+
+	bool bIsCoveredByLoadingScreen = false;
+	bool bCaptureCallstacks = false;
+	bool bLogEachLoad = false;
+	double MinDurationSecs = 0.0;
+
+	FString CurrentMapName;
+
+	struct FPendingLoad
+	{
+		double StartTime = 0.0;
+		uint32 StackHash = 0;
+	};
+
+	// Sync loads that have been requested but not finished yet. Sync loads can nest, so there can be several.
+	// A sync load blocks until it's done, so anything still pending at the next tick is dropped.
+	TMap<FName, FPendingLoad> PendingLoads;
+
+	TMap<FString, FMapStats> MapStats;
+
+	// Raw program counters of captured callstacks, keyed by their CRC. Only symbolicated when dumped.
+	TMap<uint32, TArray<uint64>> Callstacks;
+
+	FDelegateHandle SyncLoadHandle;
+	FDelegateHandle EndLoadHandle;
+	FDelegateHandle FlushHandle;
+};
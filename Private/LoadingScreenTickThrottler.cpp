@@ -0,0 +1,307 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+
+#include "LoadingScreenTickThrottler.h"
+
+#include "Components/ActorComponent.h"
+#include "GameFramework/Actor.h"
+
+#include "DevCommons.h"
+
+namespace LoadingScreenTickThrottler
+{
+    // Weight of the latest call in the moving average of a ticker's cost.
+    static constexpr double CostSmoothing = 0.1;
+}
+
+FLoadingScreenTickThrottler::FLoadingScreenTickThrottler()
+{
+    CoreTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FLoadingScreenTickThrottler::TickTickers));
+}
+
+FLoadingScreenTickThrottler::~FLoadingScreenTickThrottler()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(CoreTickerHandle);
+
+    for (FThrottledObject& Entry : Objects)
+    {
+        RestorePolicy(Entry);
+    }
+}
+
+void FLoadingScreenTickThrottler::RegisterObject(UObject* Object, ELoadingScreenTickPolicy Policy, float ReducedTickRateHz)
+{
+    if (!Cast<AActor>(Object) && !Cast<UActorComponent>(Object))
+    {
+        UE_LOG(VSLog, Warning, TEXT("Only actors and actor components can have their tick throttled by the loading screen, '%s' is neither."), *GetNameSafe(Object));
+        return;
+    }
+
+    // Re-registering changes the policy
+    UnregisterObject(Object);
+
+    FThrottledObject& Entry = Objects.AddDefaulted_GetRef();
+    Entry.Object = Object;
+    Entry.Policy = Policy;
+    Entry.ReducedTickRateHz = ReducedTickRateHz;
+
+    if (bIsThrottling)
+    {
+        ApplyPolicy(Entry);
+    }
+}
+
+void FLoadingScreenTickThrottler::UnregisterObject(UObject* Object)
+{
+    for (int32 Index = Objects.Num() - 1; Index >= 0; --Index)
+    {
+        if (Objects[Index].Object == Object)
+        {
+            RestorePolicy(Objects[Index]);
+            Objects.RemoveAtSwap(Index);
+        }
+    }
+}
+
+FDelegateHandle FLoadingScreenTickThrottler::RegisterTicker(FName DebugName, const FTickerDelegate& Delegate, ELoadingScreenTickPolicy Policy, float ReducedTickRateHz)
+{
+    FThrottledTicker& Ticker = Tickers.AddDefaulted_GetRef();
+    Ticker.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+    Ticker.DebugName = DebugName;
+    Ticker.Delegate = Delegate;
+    Ticker.Policy = Policy;
+    Ticker.ReducedTickRateHz = ReducedTickRateHz;
+
+    return Ticker.Handle;
+}
+
+void FLoadingScreenTickThrottler::UnregisterTicker(FDelegateHandle Handle)
+{
+    // Unbound rather than removed, the ticker may be unregistering itself from inside TickTickers
+    for (FThrottledTicker& Ticker : Tickers)
+    {
+        if (Ticker.Handle == Handle)
+        {
+            Ticker.Delegate.Unbind();
+        }
+    }
+}
+
+void FLoadingScreenTickThrottler::BeginThrottling()
+{
+    if (bIsThrottling)
+    {
+        return;
+    }
+
+    bIsThrottling = true;
+    ThrottleStartTime = FPlatformTime::Seconds();
+    ThrottleStartFrame = GFrameCounter;
+
+    for (FThrottledTicker& Ticker : Tickers)
+    {
+        Ticker.AccumulatedDeltaTime = 0.0f;
+        Ticker.NumSkippedCalls = 0;
+        Ticker.SavedSecs = 0.0;
+    }
+
+    for (FThrottledObject& Entry : Objects)
+    {
+        ApplyPolicy(Entry);
+    }
+}
+
+void FLoadingScreenTickThrottler::EndThrottling(const FString& MapName)
+{
+    if (!bIsThrottling)
+    {
+        return;
+    }
+
+    bIsThrottling = false;
+
+    const double ThrottledSecs = FPlatformTime::Seconds() - ThrottleStartTime;
+    const int64 ThrottledFrames = static_cast<int64>(GFrameCounter - ThrottleStartFrame);
+
+    // Engine ticks aren't timed individually, so objects are reported in ticks skipped rather than time
+    int32 NumThrottledObjects = 0;
+    int64 NumSkippedObjectTicks = 0;
+    for (FThrottledObject& Entry : Objects)
+    {
+        if (!Entry.bIsApplied)
+        {
+            continue;
+        }
+
+        ++NumThrottledObjects;
+        if (Entry.Policy == ELoadingScreenTickPolicy::Pause)
+        {
+            NumSkippedObjectTicks += ThrottledFrames;
+        }
+        else
+        {
+            NumSkippedObjectTicks += FMath::Max<int64>(ThrottledFrames - static_cast<int64>(ThrottledSecs * Entry.ReducedTickRateHz), 0);
+        }
+
+        RestorePolicy(Entry);
+    }
+
+    Objects.RemoveAllSwap([](const FThrottledObject& Entry)
+    {
+        return !Entry.Object.IsValid();
+    });
+
+    int32 NumSkippedCalls = 0;
+    double SavedSecs = 0.0;
+    for (const FThrottledTicker& Ticker : Tickers)
+    {
+        NumSkippedCalls += Ticker.NumSkippedCalls;
+        SavedSecs += Ticker.SavedSecs;
+    }
+
+    if (NumThrottledObjects > 0 || NumSkippedCalls > 0)
+    {
+        UE_LOG(VSLog, Log, TEXT("Tick throttling during '%s' (%.2f s, %lld frames): %d actors and components skipped about %lld ticks, tickers skipped %d calls saving %.2f ms of game thread time."),
+            *MapName, ThrottledSecs, ThrottledFrames, NumThrottledObjects, NumSkippedObjectTicks, NumSkippedCalls, SavedSecs * 1000.0);
+    }
+}
+
+bool FLoadingScreenTickThrottler::TickTickers(float DeltaTime)
+{
+    // By index, a ticker may register new ones while being called
+    for (int32 Index = 0; Index < Tickers.Num(); ++Index)
+    {
+        if (!Tickers[Index].Delegate.IsBound())
+        {
+            continue;
+        }
+
+        const ELoadingScreenTickPolicy Policy = bIsThrottling ? Tickers[Index].Policy : ELoadingScreenTickPolicy::KeepRunning;
+
+        if (Policy == ELoadingScreenTickPolicy::Pause)
+        {
+            ++Tickers[Index].NumSkippedCalls;
+            Tickers[Index].SavedSecs += Tickers[Index].AverageCallSecs;
+            continue;
+        }
+
+        if (Policy == ELoadingScreenTickPolicy::ReducedRate && Tickers[Index].ReducedTickRateHz > 0.0f)
+        {
+            Tickers[Index].AccumulatedDeltaTime += DeltaTime;
+            if (Tickers[Index].AccumulatedDeltaTime < 1.0f / Tickers[Index].ReducedTickRateHz)
+            {
+                ++Tickers[Index].NumSkippedCalls;
+                Tickers[Index].SavedSecs += Tickers[Index].AverageCallSecs;
+                continue;
+            }
+
+            // Called with the full time since the last call, so the ticker still sees the correct elapsed time
+            const float ElapsedTime = Tickers[Index].AccumulatedDeltaTime;
+            Tickers[Index].AccumulatedDeltaTime = 0.0f;
+
+            if (!CallTicker(Index, ElapsedTime))
+            {
+                Tickers[Index].Delegate.Unbind();
+            }
+            continue;
+        }
+
+        if (!CallTicker(Index, DeltaTime))
+        {
+            Tickers[Index].Delegate.Unbind();
+        }
+    }
+
+    Tickers.RemoveAll([](const FThrottledTicker& Ticker)
+    {
+        return !Ticker.Delegate.IsBound();
+    });
+
+    return true;
+}
+
+bool FLoadingScreenTickThrottler::CallTicker(int32 Index, float DeltaTime)
+{
+    // Copied, calling it may reallocate the array
+    const FTickerDelegate Delegate = Tickers[Index].Delegate;
+
+    const double StartTime = FPlatformTime::Seconds();
+    const bool bKeepTicking = Delegate.Execute(DeltaTime);
+    const double CallSecs = FPlatformTime::Seconds() - StartTime;
+
+    FThrottledTicker& Ticker = Tickers[Index];
+    if (Ticker.AverageCallSecs <= 0.0)
+    {
+        Ticker.AverageCallSecs = CallSecs;
+    }
+    else
+    {
+        Ticker.AverageCallSecs = FMath::Lerp(Ticker.AverageCallSecs, CallSecs, LoadingScreenTickThrottler::CostSmoothing);
+    }
+
+    return bKeepTicking;
+}
+
+void FLoadingScreenTickThrottler::ApplyPolicy(FThrottledObject& Entry)
+{
+    UObject* Object = Entry.Object.Get();
+    if (!Object || Entry.bIsApplied || Entry.Policy == ELoadingScreenTickPolicy::KeepRunning)
+    {
+        return;
+    }
+
+    // Never speeds up something that already ticks slower than the reduced rate
+    const float ReducedTickInterval = Entry.ReducedTickRateHz > 0.0f ? 1.0f / Entry.ReducedTickRateHz : 0.0f;
+
+    if (AActor* Actor = Cast<AActor>(Object))
+    {
+        Entry.bOriginalTickEnabled = Actor->IsActorTickEnabled();
+        Entry.OriginalTickInterval = Actor->GetActorTickInterval();
+
+        if (Entry.Policy == ELoadingScreenTickPolicy::Pause)
+        {
+            Actor->SetActorTickEnabled(false);
+        }
+        else
+        {
+            Actor->SetActorTickInterval(FMath::Max(Entry.OriginalTickInterval, ReducedTickInterval));
+        }
+    }
+    else if (UActorComponent* Component = Cast<UActorComponent>(Object))
+    {
+        Entry.bOriginalTickEnabled = Component->IsComponentTickEnabled();
+        Entry.OriginalTickInterval = Component->GetComponentTickInterval();
+
+        if (Entry.Policy == ELoadingScreenTickPolicy::Pause)
+        {
+            Component->SetComponentTickEnabled(false);
+        }
+        else
+        {
+            Component->SetComponentTickInterval(FMath::Max(Entry.OriginalTickInterval, ReducedTickInterval));
+        }
+    }
+
+    Entry.bIsApplied = true;
+}
+
+void FLoadingScreenTickThrottler::RestorePolicy(FThrottledObject& Entry)
+{
+    if (!Entry.bIsApplied)
+    {
+        return;
+    }
+
+    Entry.bIsApplied = false;
+
+    if (AActor* Actor = Cast<AActor>(Entry.Object.Get()))
+    {
+        Actor->SetActorTickInterval(Entry.OriginalTickInterval);
+        Actor->SetActorTickEnabled(Entry.bOriginalTickEnabled);
+    }
+    else if (UActorComponent* Component = Cast<UActorComponent>(Entry.Object.Get()))
+    {
+        Component->SetComponentTickInterval(Entry.OriginalTickInterval);
+        Component->SetComponentTickEnabled(Entry.bOriginalTickEnabled);
+    }
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+#include "LoadingScreenSubsystem.h"
+
+/*
+* Pauses or slows down ticking of registered actors, components and tickers while the loading screen is up,
+* so that the game thread time goes to loading instead. Reports the time saved when the screen is hidden.
+*/
+class FLoadingScreenTickThrottler
+{
+public:
+	FLoadingScreenTickThrottler();
+	~FLoadingScreenTickThrottler();
+
+	// Actors and actor components. Applied immediately if already throttling.
+	void RegisterObject(UObject* Object, ELoadingScreenTickPolicy Policy, float ReducedTickRateHz);
+	void UnregisterObject(UObject* Object);
+
+	// Called from the core ticker every frame, and throttled according to the policy while loading. Returning false unregisters it.
+	FDelegateHandle RegisterTicker(FName DebugName, const FTickerDelegate& Delegate, ELoadingScreenTickPolicy Policy, float ReducedTickRateHz);
+	void UnregisterTicker(FDelegateHandle Handle);
+
+	// Applies the policies. Called when the loading screen is shown.
+	void BeginThrottling();
+
+	// Restores the original tick settings, and logs how much game thread time was saved during the transition.
+	void EndThrottling(const FString& MapName);
+
+	bool IsThrottling() const { return bIsThrottling; }
+
+private:
+	struct FThrottledObject
+	{
+		TWeakObjectPtr<UObject> Object;
+		ELoadingScreenTickPolicy Policy = ELoadingScreenTickPolicy::KeepRunning;
+		float ReducedTickRateHz = 0.0f;
+
+		// What the policy replaced, restored when throttling ends
+		bool bOriginalTickEnabled = true;
+		float OriginalTickInterval = 0.0f;
+		bool bIsApplied = false;
+	};
+
+	struct FThrottledTicker
+	{
+		FDelegateHandle Handle;
+		FName DebugName;
+		FTickerDelegate Delegate;
+		ELoadingScreenTickPolicy Policy = ELoadingScreenTickPolicy::KeepRunning;
+		float ReducedTickRateHz = 0.0f;
+
+		// Time since the last call while running at a reduced rate
+		float AccumulatedDeltaTime = 0.0f;
+
+		// Moving average of what a call costs, used to value the skipped ones
+		double AverageCallSecs = 0.0;
+
+		int32 NumSkippedCalls = 0;
+		double SavedSecs = 0.0;
+	};
+
+	bool TickTickers(float DeltaTime);
+
+	// Calls the ticker at Index and updates its average cost. Returns false if it asked to be removed.
+	bool CallTicker(int32 Index, float DeltaTime);
+
+	void ApplyPolicy(FThrottledObject& Entry);
+	void RestorePolicy(FThrottledObject& Entry);
+
+	TArray<FThrottledObject> Objects;
+	TArray<FThrottledTicker> Tickers;
+
+	FTSTicker::FDelegateHandle CoreTickerHandle;
+
+	bool bIsThrottling = false;
+	double ThrottleStartTime = 0.0;
+	uint64 ThrottleStartFrame = 0;
+};
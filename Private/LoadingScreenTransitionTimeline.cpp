@@ -0,0 +1,98 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+
+#include "LoadingScreenTransitionTimeline.h"
+
+#include "UObject/Class.h"
+
+void FLoadingScreenTransitionTimeline::Begin(const FString& InMapName)
+{
+    MapName = InMapName;
+    StartTime = FPlatformTime::Seconds();
+    EndTime = StartTime;
+    Spans.Reset();
+    bIsActive = true;
+}
+
+void FLoadingScreenTransitionTimeline::EnterPhase(ELoadingScreenPhase Phase)
+{
+    if (!bIsActive)
+    {
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+
+    if (!Spans.IsEmpty())
+    {
+        FLoadingScreenPhaseSpan& CurrentSpan = Spans.Last();
+        CurrentSpan.EndTime = Now;
+
+        if (CurrentSpan.Phase == Phase)
+        {
+            return;
+        }
+    }
+
+    FLoadingScreenPhaseSpan& NewSpan = Spans.AddDefaulted_GetRef();
+    NewSpan.Phase = Phase;
+    NewSpan.StartTime = Now;
+    NewSpan.EndTime = Now;
+}
+
+void FLoadingScreenTransitionTimeline::End()
+{
+    if (!bIsActive)
+    {
+        return;
+    }
+
+    EndTime = FPlatformTime::Seconds();
+    if (!Spans.IsEmpty())
+    {
+        Spans.Last().EndTime = EndTime;
+    }
+
+    bIsActive = false;
+}
+
+ELoadingScreenPhase FLoadingScreenTransitionTimeline::GetCurrentPhase() const
+{
+    return (bIsActive && !Spans.IsEmpty()) ? Spans.Last().Phase : ELoadingScreenPhase::None;
+}
+
+double FLoadingScreenTransitionTimeline::GetDuration() const
+{
+    return (bIsActive ? FPlatformTime::Seconds() : EndTime) - StartTime;
+}
+
+double FLoadingScreenTransitionTimeline::GetPhaseDuration(ELoadingScreenPhase Phase) const
+{
+    double Duration = 0.0;
+    for (const FLoadingScreenPhaseSpan& Span : Spans)
+    {
+        if (Span.Phase == Phase)
+        {
+            Duration += Span.GetDuration();
+        }
+    }
+
+    return Duration;
+}
+
+FString FLoadingScreenTransitionTimeline::ToString() const
+{
+    TArray<ELoadingScreenPhase, TInlineAllocator<16>> PhasesInOrder;
+    for (const FLoadingScreenPhaseSpan& Span : Spans)
+    {
+        PhasesInOrder.AddUnique(Span.Phase);
+    }
+
+    FString Result = FString::Printf(TEXT("'%s' took %.3f s"), *MapName, GetDuration());
+    for (const ELoadingScreenPhase Phase : PhasesInOrder)
+    {
+        Result += FString::Printf(TEXT(", %s %.3f s"), *UEnum::GetDisplayValueAsText(Phase).ToString(), GetPhaseDuration(Phase));
+    }
+
+    return Result;
+}
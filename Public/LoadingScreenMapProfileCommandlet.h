@@ -0,0 +1,57 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "LoadingScreenMapProfileCommandlet.generated.h"
+
+/*
+* Profiles the load cost of maps offline, without starting the game.
+* For every map it computes the hard dependency closure, its total size on disk and the number of packages loaded
+* synchronously together with the map, and optionally times a headless load of it. Results are written as CSV and JSON.
+*
+* Usage:
+*   -run=LoadingScreenMapProfile -Maps=/Game/Maps/A+/Game/Maps/B
+*   -run=LoadingScreenMapProfile -MapDir=/Game/Maps [-MapList=Maps.txt] [-TimedLoad] [-Output=Path/Without/Extension]
+*   [-MaxClosureMB=512] [-MaxClosurePackages=5000]
+*
+* Returns a non-zero exit code if any map goes over one of the budgets, so that build CI can fail on it.
+*/
+UCLASS()
+class VERTICALSLICE_API ULoadingScreenMapProfileCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	ULoadingScreenMapProfileCommandlet();
+
+	// --- Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	// --- End UCommandlet Interface
+
+private:
+	struct FMapProfile
+	{
+		FName MapName;
+		int32 NumPackages = 0;
+		// Every package in the hard closure is loaded synchronously with the map, so this is the closure without the map itself.
+		int32 NumSyncLoadedReferences = 0;
+		int32 NumSoftReferences = 0;
+		int64 ClosureDiskSize = 0;
+
+		// Negative if no timed load was made, or it failed. Written as n/a to the log and CSV and as null to the JSON.
+		double LoadSecs = -1.0;
+
+		bool bOverBudget = false;
+	};
+
+	// Collects the maps to profile from -Maps, -MapList and -MapDir.
+	TArray<FName> GatherMaps(const TMap<FString, FString>& ParamsMap) const;
+
+	FMapProfile ProfileMap(FName MapName, bool bTimedLoad) const;
+
+	bool WriteCsv(const FString& Path, const TArray<FMapProfile>& Profiles) const;
+	bool WriteJson(const FString& Path, const TArray<FMapProfile>& Profiles) const;
+};
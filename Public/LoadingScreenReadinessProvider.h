@@ -0,0 +1,44 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+
+#include "LoadingScreenReadinessProvider.generated.h"
+
+// How the subsystem finds out that a readiness provider has changed its mind.
+UENUM(BlueprintType)
+enum class ELoadingScreenReadinessMode : uint8
+{
+	// Queried every time the loading screen is evaluated.
+	Polled,
+	// Only queried after it calls ULoadingScreenSubsystem::NotifyReadinessChanged. The last answer is reused until then.
+	Push,
+};
+
+UINTERFACE(BlueprintType, meta = (CannotImplementInterfaceInBlueprint))
+class VERTICALSLICE_API ULoadingScreenReadinessProvider : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/*
+* Implemented by game objects, components or subsystems that need the loading screen to stay up while they get ready.
+* Register the object with ULoadingScreenSubsystem::RegisterReadinessProvider, and unregister it once it's no longer relevant.
+* Providers are held weakly, so destroyed ones are dropped automatically.
+*/
+class VERTICALSLICE_API ILoadingScreenReadinessProvider
+{
+	GENERATED_BODY()
+
+public:
+	// Returns true if the loading screen needs to stay up, with a human readable reason.
+	virtual bool IsBlockingLoadingScreen(FString& OutReason) const = 0;
+
+	// Of all blocking providers, the reason of the one with the highest priority is the one reported. Read once, on registration.
+	virtual int32 GetReadinessPriority() const { return 0; }
+
+	// Read once, on registration.
+	virtual ELoadingScreenReadinessMode GetReadinessMode() const { return ELoadingScreenReadinessMode::Polled; }
+};
@@ -4,8 +4,34 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DeveloperSettings.h"
+#include "Engine/World.h"
+#include "WorldPartition/DataLayer/DataLayerAsset.h"
 #include "LoadingScreenSettings.generated.h"
 
+// How long the loading screen widget and the assets it references stay in memory.
+UENUM()
+enum class ELoadingScreenResidencyPolicy : uint8
+{
+	// Loaded at startup and never unloaded. The screen shows without any loading, at the cost of memory during gameplay.
+	AlwaysResident,
+	// Unloaded once the screen is hidden, and async loaded again when PreloadLoadingScreenAssets is called ahead of a travel.
+	PreloadOnTravelIntent,
+	// Unloaded once the screen is hidden, and loaded synchronously when it's shown again.
+	LoadOnDemand,
+};
+
+// What the loading screen widget is wrapped in before it's added to the viewport, to cut the cost of painting it every frame.
+UENUM()
+enum class ELoadingScreenWidgetWrapping : uint8
+{
+	// Painted from scratch every frame.
+	None,
+	// Caches the widget's draw elements and only repaints what was invalidated or is volatile, such as animated elements.
+	InvalidationPanel,
+	// Renders the widget into a render target every RetainedRenderPhaseCount frames, and draws that target in between.
+	RetainerPanel,
+};
+
 /**
  * Settings for the custom loading screen.
  * Allows us to pass parameters and values to the Subsystem from the Editor, since Subsystems can't be derived in Blueprint.
@@ -29,6 +55,28 @@ public:
 	UPROPERTY(Config, EditAnywhere, meta = (ForceUnits = s))
 	float HoldLoadingScreenAdditionalSecs = 2.0f;
 
+	// Once shown, the loading screen stays up at least this long, even if every reason to show it goes away sooner.
+	UPROPERTY(Config, EditAnywhere, meta = (ForceUnits = s, ClampMin = 0))
+	float MinimumDisplaySecs = 0.0f;
+
+	// Once hidden, requests from game logic, Game Feature plugins and readiness providers have to persist this long before the screen is shown again.
+	// Map loads and travel are always covered immediately.
+	UPROPERTY(Config, EditAnywhere, meta = (ForceUnits = s, ClampMin = 0))
+	float MinimumHiddenSecs = 0.0f;
+
+	// Menus requested through RequestMenuTransition that take longer than this to load are covered by the loading screen. Faster ones open without it.
+	UPROPERTY(Config, EditAnywhere, meta = (ForceUnits = s, ClampMin = 0))
+	float MenuTransitionLoadingScreenDelaySecs = 0.25f;
+
+	// The most packages soft referenced by a menu widget that RequestMenuTransition loads along with it. Anything past this is left to load when the menu asks for it.
+	// Set to 0 to only load the widget class and its hard references.
+	UPROPERTY(Config, EditAnywhere, meta = (ClampMin = 0))
+	int32 MaxMenuPrefetchPackages = 32;
+
+	// Waits this long after the last reason to show goes away before hiding. A request arriving in the meantime continues the same session.
+	UPROPERTY(Config, EditAnywhere, meta = (ForceUnits = s, ClampMin = 0))
+	float CoalescingWindowSecs = 0.0f;
+
 	UPROPERTY(Config, EditAnywhere, Category = "Debugging")
 	bool bForceDisplayLoadingScreen = false;
 
@@ -37,4 +85,210 @@ public:
 
 	UPROPERTY(Config, EditAnywhere, Category = "Debugging")
 	bool bShowLoadingScreenAdditionalSecsInEditor = false;
+
+	// A tiny map that TravelWithPreload passes through on its way to the destination. Leave empty to travel directly.
+	// Only the short load of this map blocks the game thread, the destination is then async loaded while the world ticks and the widget keeps animating.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (AllowedClasses = "/Script/Engine.World"))
+	FSoftObjectPath TransitionMap;
+
+	// Shows the loading screen as soon as a travel is requested, such as OpenLevel, ClientTravel or a client connecting to a server, instead of at PreLoadMap.
+	// The widget is constructed, the performance settings applied and the screen painted before the engine blocks in LoadMap.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bShowOnTravelIntent = false;
+
+	// Also starts async loading the destination map as soon as the travel is requested, so LoadMap finds part of it already loaded.
+	// Only for local travel to a long package name outside the editor. Connecting to a server doesn't know the map until it's about to load it.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (EditCondition = "bShowOnTravelIntent"))
+	bool bPrefetchDestinationOnTravelIntent = true;
+
+	// Picks how to present each map transition from how long loading the same map took before, kept in Saved/LoadingScreen across sessions.
+	// Loads predicted to finish within ShortLoadThresholdSecs get a small Slate indicator or nothing, since building the full widget costs more than it hides.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bUseTieredPresentation = false;
+
+	// Loads predicted to be shorter than this don't get the full widget. A short load still going after this long switches to it.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ForceUnits = s, ClampMin = 0, EditCondition = "bUseTieredPresentation"))
+	float ShortLoadThresholdSecs = 0.5f;
+
+	// Shows a throbber in the corner during short loads, instead of nothing at all.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (EditCondition = "bUseTieredPresentation"))
+	bool bShowIndicatorForShortLoads = true;
+
+	// The indicator only appears once a short load has taken this long, so the shortest ones show nothing.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ForceUnits = s, ClampMin = 0, EditCondition = "bUseTieredPresentation && bShowIndicatorForShortLoads"))
+	float ShortLoadIndicatorDelaySecs = 0.2f;
+
+	// Draws the loading screen widget once into an off-screen render target when the game instance starts, so its materials, font glyphs and brushes
+	// are compiled and uploaded before the first real show. Most useful with the AlwaysResident policy, since unloading the widget also unloads its materials.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bPrewarmWidgetAtStartup = false;
+
+	// Wraps the loading screen widget so that its mostly static content isn't painted from scratch every frame. The Slate time per frame
+	// with each option is logged per transition and compared with LoadingScreen.SlateReport.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	ELoadingScreenWidgetWrapping WidgetWrapping = ELoadingScreenWidgetWrapping::None;
+
+	// The retainer panel renders the widget on one frame out of this many. Animations run at the reduced rate.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = 1, EditCondition = "WidgetWrapping == ELoadingScreenWidgetWrapping::RetainerPanel"))
+	int32 RetainedRenderPhaseCount = 2;
+
+	// How the loading screen widget and its textures are kept in memory between transitions. The footprint and load time of each option
+	// are printed with LoadingScreen.ResidencyReport.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	ELoadingScreenResidencyPolicy WidgetResidencyPolicy = ELoadingScreenResidencyPolicy::LoadOnDemand;
+
+	// Keeps assets that the outgoing map shares with the destination loaded through the transition, instead of collecting them and loading them again.
+	// Makes restarting a map or returning to a hub mostly skip disk I/O. Released once the loading screen is hidden.
+	// Needs the asset registry dependencies, which packaged builds only have with bSerializeDependencies=true under [AssetRegistry] in DefaultEngine.ini.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bRetainSharedAssetsAcrossTransitions = false;
+
+	// The maximum estimated memory of assets kept across a transition. Assets that would exceed it are collected as usual.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ForceUnits = MB, ClampMin = 0, EditCondition = "bRetainSharedAssetsAcrossTransitions"))
+	int32 RetainedAssetsMemoryCapMB = 256;
+
+	// On World Partition maps, keeps the loading screen up until the cells around all streaming sources have been loaded and made visible.
+	UPROPERTY(Config, EditAnywhere, Category = "Readiness")
+	bool bWaitForWorldPartitionStreaming = false;
+
+	// Data layers that have to be activated before the loading screen is removed. Ignored on maps that don't use them.
+	UPROPERTY(Config, EditAnywhere, Category = "Readiness", meta = (EditCondition = "bWaitForWorldPartitionStreaming"))
+	TArray<TSoftObjectPtr<UDataLayerAsset>> RequiredDataLayers;
+
+	// Gives up on World Partition streaming after this long, so a streaming source stuck out of bounds can't keep the screen up forever.
+	UPROPERTY(Config, EditAnywhere, Category = "Readiness", meta = (ForceUnits = s, ClampMin = 0, EditCondition = "bWaitForWorldPartitionStreaming"))
+	float WorldPartitionStreamingTimeoutSecs = 30.0f;
+
+	// Keeps the loading screen up while streaming sublevels are loading, registering their components in large batches behind the screen.
+	// Once everything is loaded, the remaining levels are made visible in a single flush before the reveal instead of across dozens of hitching frames.
+	UPROPERTY(Config, EditAnywhere, Category = "Readiness")
+	bool bWaitForStreamingLevels = false;
+
+	// Components registered and actors updated per step while the loading screen covers level streaming. The engine defaults are tuned for gameplay.
+	UPROPERTY(Config, EditAnywhere, Category = "Readiness", meta = (ClampMin = 1, EditCondition = "bWaitForStreamingLevels"))
+	int32 StreamingLevelsRegistrationGranularity = 5000;
+
+	// Gives up on streaming levels after this long, so a level stuck loading can't keep the screen up forever.
+	UPROPERTY(Config, EditAnywhere, Category = "Readiness", meta = (ForceUnits = s, ClampMin = 0, EditCondition = "bWaitForStreamingLevels"))
+	float StreamingLevelsTimeoutSecs = 30.0f;
+
+	// On network clients, keeps the loading screen up until the local player controller has possessed a pawn and the initial replication burst has settled.
+	// Begin play happens before any of that has replicated, so without it the world pops in after the reveal. Has no effect in standalone or on the host.
+	UPROPERTY(Config, EditAnywhere, Category = "Readiness")
+	bool bWaitForNetworkReadiness = false;
+
+	// Replication is considered settled once no replicated actors have been added or removed for this long.
+	UPROPERTY(Config, EditAnywhere, Category = "Readiness", meta = (ForceUnits = s, ClampMin = 0, EditCondition = "bWaitForNetworkReadiness"))
+	float NetworkReplicationSettleSecs = 0.5f;
+
+	// Gives up on network readiness after this long, so a spectator or a slow connection can't keep the screen up forever.
+	UPROPERTY(Config, EditAnywhere, Category = "Readiness", meta = (ForceUnits = s, ClampMin = 0, EditCondition = "bWaitForNetworkReadiness"))
+	float NetworkReadinessTimeoutSecs = 15.0f;
+
+	// Reveals the world at a lower screen percentage and raises it back to the user's setting over the first moments of gameplay,
+	// while caches are still cold and streaming hasn't fully converged. The original value is restored exactly once the ramp is done.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bRampQualityAfterReveal = false;
+
+	// The screen percentage the world is revealed at, as a percentage of the user's setting.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = 10, ClampMax = 100, EditCondition = "bRampQualityAfterReveal"))
+	float PostRevealStartScreenPercentage = 50.0f;
+
+	// How long the ramp takes when every frame is within PostRevealTargetFrameTimeMs.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ForceUnits = s, ClampMin = 0, EditCondition = "bRampQualityAfterReveal"))
+	float PostRevealRampSecs = 2.0f;
+
+	// The ramp only advances on frames faster than this, so it waits out hitches instead of making them worse.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ForceUnits = ms, ClampMin = 1, EditCondition = "bRampQualityAfterReveal"))
+	float PostRevealTargetFrameTimeMs = 33.3f;
+
+	// Full quality is restored after this long regardless of frame times.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ForceUnits = s, ClampMin = 0, EditCondition = "bRampQualityAfterReveal"))
+	float PostRevealMaxRampSecs = 6.0f;
+
+	// Keeps world rendering disabled while holding the loading screen, and instead feeds the texture streamer the view from the expected spawn point.
+	// Avoids rendering frames that are hidden behind the loading screen. Rendering is only turned on for the last moments before the reveal.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bPrimeTextureStreamingWithoutRendering = false;
+
+	// How long before the loading screen is removed that world rendering is turned back on, so the first revealed frame is fully formed.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ForceUnits = s, ClampMin = 0, EditCondition = "bPrimeTextureStreamingWithoutRendering"))
+	float StreamingPrimingRenderLeadSecs = 0.25f;
+
+	// Used when priming from a player start, where there is no camera to take the field of view from.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ForceUnits = deg, ClampMin = 5, ClampMax = 170, EditCondition = "bPrimeTextureStreamingWithoutRendering"))
+	float StreamingPrimingDefaultFOV = 90.0f;
+
+	// Samples the game thread's callstack from a background thread while a map is loading, and writes a hot-stack report to Saved/LoadingScreen when the screen is revealed.
+	UPROPERTY(Config, EditAnywhere, Category = "Debugging")
+	bool bEnableStallWatchdog = false;
+
+	// How often the watchdog samples the game thread while armed.
+	UPROPERTY(Config, EditAnywhere, Category = "Debugging", meta = (ForceUnits = ms, ClampMin = 1, EditCondition = "bEnableStallWatchdog"))
+	float StallWatchdogSampleIntervalMs = 10.0f;
+
+	// The maximum number of frames captured per sample. Deeper stacks are truncated at the outermost frames.
+	UPROPERTY(Config, EditAnywhere, Category = "Debugging", meta = (ClampMin = 4, ClampMax = 128, EditCondition = "bEnableStallWatchdog"))
+	int32 StallWatchdogMaxStackDepth = 48;
+
+	// How many of the hottest unique stacks to write to the report.
+	UPROPERTY(Config, EditAnywhere, Category = "Debugging", meta = (ClampMin = 1, EditCondition = "bEnableStallWatchdog"))
+	int32 StallWatchdogStacksInReport = 20;
+
+	// Records every package loaded while the loading screen is up, with load duration, size and whether it was loaded synchronously.
+	// The latest report can be printed with LoadingScreen.PackageReport.
+	UPROPERTY(Config, EditAnywhere, Category = "Debugging")
+	bool bTrackPackageLoads = false;
+
+	// Writes each transition's package report as JSON to Saved/LoadingScreen.
+	UPROPERTY(Config, EditAnywhere, Category = "Debugging", meta = (EditCondition = "bTrackPackageLoads"))
+	bool bWritePackageLoadReport = true;
+
+	// How many of the most expensive packages to include in the package report.
+	UPROPERTY(Config, EditAnywhere, Category = "Debugging", meta = (ClampMin = 1, EditCondition = "bTrackPackageLoads"))
+	int32 PackageLoadReportTopN = 25;
+
+	// Flags synchronous loads and async loading flushes that happen while the loading screen is down, since those are hitches it doesn't cover.
+	// Aggregated per map and printed with LoadingScreen.SyncLoadReport. Written as JSON to Saved/LoadingScreen when the game instance shuts down.
+	UPROPERTY(Config, EditAnywhere, Category = "Debugging")
+	bool bTrackSyncLoadsOutsideLoadingScreen = false;
+
+	// Loads faster than this are not recorded.
+	UPROPERTY(Config, EditAnywhere, Category = "Debugging", meta = (ForceUnits = ms, ClampMin = 0, EditCondition = "bTrackSyncLoadsOutsideLoadingScreen"))
+	float SyncLoadMinDurationMs = 1.0f;
+
+	// Captures the callstack of each sync load, to find the code that triggered it. Adds a small cost to every sync load.
+	UPROPERTY(Config, EditAnywhere, Category = "Debugging", meta = (EditCondition = "bTrackSyncLoadsOutsideLoadingScreen"))
+	bool bCaptureSyncLoadCallstacks = true;
+
+	// Logs a warning for every sync load outside the loading screen as it happens.
+	UPROPERTY(Config, EditAnywhere, Category = "Debugging", meta = (EditCondition = "bTrackSyncLoadsOutsideLoadingScreen"))
+	bool bLogSyncLoadsOutsideLoadingScreen = false;
+
+	// Samples process memory when the loading screen is shown, at PreLoadMap, PostLoadMap and at the reveal, and tracks the peak in between.
+	// Peaks are logged per transition and printed per map with LoadingScreen.MemoryReport.
+	UPROPERTY(Config, EditAnywhere, Category = "Debugging")
+	bool bTrackTransitionMemory = false;
+
+	// Compares each transition against its load budget, and writes a diagnostic bundle to Saved/LoadingScreen when it goes over.
+	// The bundle has the phase timeline, memory stats and, if bTrackPackageLoads is on, the packages loaded.
+	UPROPERTY(Config, EditAnywhere, Category = "Budgets")
+	bool bMonitorLoadBudgets = false;
+
+	// Budget for maps that aren't in MapLoadBudgets. Zero means they have no budget.
+	UPROPERTY(Config, EditAnywhere, Category = "Budgets", meta = (ForceUnits = s, ClampMin = 0, EditCondition = "bMonitorLoadBudgets"))
+	float DefaultLoadBudgetSecs = 0.0f;
+
+	// How long the loading screen may be up when transitioning to each map, from shown to hidden, not counting HoldLoadingScreenAdditionalSecs.
+	// Only checked for transitions that loaded a map, screens shown by game logic or menus have no budget.
+	UPROPERTY(Config, EditAnywhere, Category = "Budgets", meta = (ForceUnits = s, EditCondition = "bMonitorLoadBudgets"))
+	TMap<TSoftObjectPtr<UWorld>, float> MapLoadBudgets;
+
+	// Also runs MemReport when a budget is exceeded. Thorough, but takes a while and writes to Saved/Profiling/MemReports.
+	UPROPERTY(Config, EditAnywhere, Category = "Budgets", meta = (EditCondition = "bMonitorLoadBudgets"))
+	bool bRunMemReportOnBudgetExceeded = false;
+
+	// Also writes a trace snapshot to the bundle. Requires tracing to be running with a tail buffer large enough to cover the transition.
+	UPROPERTY(Config, EditAnywhere, Category = "Budgets", meta = (EditCondition = "bMonitorLoadBudgets"))
+	bool bWriteTraceSnapshotOnBudgetExceeded = false;
 };
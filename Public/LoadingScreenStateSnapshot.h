@@ -0,0 +1,54 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "LoadingScreenTransitionTimeline.h"
+
+#include <atomic>
+
+// The loading screen state as of the latest publish. A plain copy, safe to keep around on any thread.
+struct FLoadingScreenStateSnapshot
+{
+	bool bIsVisible = false;
+
+	ELoadingScreenPhase Phase = ELoadingScreenPhase::None;
+
+	// 0 to 1. Negative when the current phase has no meaningful estimate.
+	float Progress = 1.0f;
+
+	// Seconds left of HoldLoadingScreenAdditionalSecs, zero when not holding.
+	float HoldTimeRemaining = 0.0f;
+
+	// How many independent requests are keeping the screen up: travel, game logic, Game Feature plugins and blocking readiness providers.
+	int32 NumActiveRequests = 0;
+
+	// Increases with every publish, zero before the first one. Lets readers skip work when nothing was published since they last looked.
+	uint32 Version = 0;
+};
+
+/*
+* Publishes FLoadingScreenStateSnapshot from the game thread to readers on any thread, without locks.
+* A sequence lock: the writer makes the sequence odd while it writes, and readers retry if they saw an odd or changed sequence.
+* Readers never block the writer, and only ever retry for the few stores a publish takes.
+*/
+class VERTICALSLICE_API FLoadingScreenStatePublisher
+{
+public:
+	// Game thread only, there can only be one writer at a time.
+	void Publish(const FLoadingScreenStateSnapshot& Snapshot);
+
+	// Any thread.
+	FLoadingScreenStateSnapshot Read() const;
+
+private:
+	std::atomic<uint32> Sequence = 0;
+
+	// Individually atomic so that a torn read is well defined, the sequence is what makes the set consistent
+	std::atomic<bool> bIsVisible = false;
+	std::atomic<uint8> Phase = 0;
+	std::atomic<float> Progress = 1.0f;
+	std::atomic<float> HoldTimeRemaining = 0.0f;
+	std::atomic<int32> NumActiveRequests = 0;
+};
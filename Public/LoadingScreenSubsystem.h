@@ -3,20 +3,81 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 
+#include "Containers/Ticker.h"
+#include "Templates/SubclassOf.h"
 #include "Tickable.h"
+#include "UObject/ScriptInterface.h"
+
+#include "LoadingScreenStateSnapshot.h"
+#include "LoadingScreenTransitionTimeline.h"
 
 #include "LoadingScreenSubsystem.generated.h"
 
+class FLoadingScreenCVarOverrides;
+class FLoadingScreenLoadHistory;
+class FLoadingScreenMemoryTracker;
+class FLoadingScreenPackageTracker;
+class FLoadingScreenStallWatchdog;
+class FLoadingScreenSyncLoadTracker;
+class FLoadingScreenTickThrottler;
+class APlayerController;
+class FOutputDevice;
+class ILoadingScreenReadinessProvider;
 class SWidget;
+class SWindow;
 class UObject;
+class UPackage;
+class UUserWidget;
 class UWorld;
 struct FFrame; 
+struct FLoadingScreenPackageReport;
+struct FStreamableHandle;
 struct FWorldContext;
 
+enum class ELoadingScreenWidgetWrapping : uint8;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnHoldTimeTriggeredSignature, float, HoldTime);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnVisibilityChangedSignature, bool, Visiblity);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnMenuTransitionCompleteSignature, UUserWidget*, MenuWidget);
+
+// What happens to a registered tick while the loading screen is up.
+UENUM(BlueprintType)
+enum class ELoadingScreenTickPolicy : uint8
+{
+	// Doesn't tick at all until the loading screen is hidden.
+	Pause,
+	// Ticks at ReducedTickRateHz, unless it already ticks slower than that.
+	ReducedRate,
+	// Ticks as usual. For things that have to keep going, registered to make that explicit.
+	KeepRunning,
+};
+
+// How a loading screen session is presented, chosen from the predicted load time when bUseTieredPresentation is on.
+UENUM(BlueprintType)
+enum class ELoadingScreenPresentationTier : uint8
+{
+	// The configured widget.
+	Full,
+	// A small Slate throbber, shown after ShortLoadIndicatorDelaySecs.
+	Indicator,
+	// Nothing is drawn, the load is expected to be over before it would be noticed.
+	None,
+};
+
+// Where a travel started through the subsystem currently is.
+enum class ELoadingScreenTravelState : uint8
+{
+	None,
+	// Travelling to the transition map from settings, the destination is preloaded once it's loaded.
+	LoadingTransitionMap,
+	// The destination map is being async loaded while the loading screen is up.
+	PreloadingDestination,
+	// The travel has been handed to the engine, waiting for it to start LoadMap.
+	WaitingForLoadMap,
+};
 
 
 /*
@@ -62,17 +123,132 @@ public:
 	UFUNCTION(BlueprintCallable)
 	float GetAdditionalTimeRemaining() const;
 
+	// Shows the loading screen immediately and async loads the destination map and its dependencies while the screen animates.
+	// Travel is only issued once everything is resident, so the blocking LoadMap mostly finds already loaded objects.
+	// If a TransitionMap is set in settings, travels there first so the outgoing world is unloaded before the preload starts.
+	// MapName can be a long package name (/Game/Maps/MyMap) or a short map name. Options are appended to the travel URL (e.g. "listen").
+	UFUNCTION(BlueprintCallable)
+	void TravelWithPreload(const FString& MapName, const FString& Options);
+
+	// Loads and activates the Game Feature plugins, all at once so they load concurrently. The loading screen stays up until every one of them has finished.
+	// Takes plugin names, such as "ShooterCore". Plugins that are already active finish immediately.
+	UFUNCTION(BlueprintCallable)
+	void LoadAndActivateGameFeatures(const TArray<FString>& PluginNames);
+
+	// Async loads a menu widget and the assets it soft references, then constructs it and passes it to OnComplete without adding it to the viewport.
+	// The loading screen covers the load if it takes longer than MenuTransitionLoadingScreenDelaySecs. OnComplete gets null if the class failed to load.
+	// The soft referenced assets are kept loaded for as long as the widget exists.
+	UFUNCTION(BlueprintCallable)
+	void RequestMenuTransition(TSoftClassPtr<UUserWidget> MenuWidgetClass, APlayerController* OwningPlayer, FOnMenuTransitionCompleteSignature OnComplete);
+
+	// Returns what the loading screen is currently waiting for. None if it isn't displayed.
+	UFUNCTION(BlueprintCallable)
+	ELoadingScreenPhase GetCurrentPhase() const;
+
+	// How the current or latest loading screen session is presented.
+	UFUNCTION(BlueprintCallable)
+	ELoadingScreenPresentationTier GetPresentationTier() const { return PresentationTier; }
+
+	// Seconds from the latest show to the first frame Slate painted the loading screen in. Negative until painted once.
+	UFUNCTION(BlueprintCallable)
+	float GetLastTimeToFirstPaint() const { return LastTimeToFirstPaintSecs; }
+
+	// How many times the minimum on and off times and the coalescing window have kept the loading screen from toggling, since startup.
+	UFUNCTION(BlueprintCallable)
+	int32 GetNumFlapsPrevented() const { return NumFlapsPrevented; }
+
+	// The latest published loading screen state. Safe to call from any thread, such as workers, audio or rendering, and never blocks.
+	// With several game instances (PIE), this is whichever instance published last.
+	static FLoadingScreenStateSnapshot GetStateSnapshot();
+
+	// The phases of the current transition, or of the latest one if the loading screen isn't displayed.
+	const FLoadingScreenTransitionTimeline& GetTransitionTimeline() const { return TransitionTimeline; }
+
+	// Adds a provider that can keep the loading screen up. Its priority and readiness mode are read here.
+	void RegisterReadinessProvider(TScriptInterface<ILoadingScreenReadinessProvider> Provider);
+
+	void UnregisterReadinessProvider(TScriptInterface<ILoadingScreenReadinessProvider> Provider);
+
+	// Tells the subsystem to query a Push provider again on the next evaluation. Does nothing for Polled providers.
+	void NotifyReadinessChanged(TScriptInterface<ILoadingScreenReadinessProvider> Provider);
+
+	// Pauses or slows down the tick of an actor or actor component while the loading screen is up, restoring it once hidden.
+	// Registering again changes the policy. Destroyed objects are dropped automatically.
+	UFUNCTION(BlueprintCallable)
+	void RegisterTickThrottle(UObject* ActorOrComponent, ELoadingScreenTickPolicy Policy, float ReducedTickRateHz = 2.0f);
+
+	UFUNCTION(BlueprintCallable)
+	void UnregisterTickThrottle(UObject* ActorOrComponent);
+
+	// Calls Delegate every frame from the core ticker, throttled according to Policy while the loading screen is up.
+	// For tickables that aren't actors or components. The delegate returning false unregisters it.
+	FDelegateHandle RegisterThrottledTicker(FName DebugName, const FTickerDelegate& Delegate, ELoadingScreenTickPolicy Policy, float ReducedTickRateHz = 2.0f);
+
+	void UnregisterThrottledTicker(FDelegateHandle Handle);
+
+	// Starts async loading the loading screen widget and its assets ahead of a travel, so showing it doesn't have to load them synchronously.
+	// Does nothing with the LoadOnDemand residency policy, while the screen is displayed, or if they are already loaded or loading.
+	UFUNCTION(BlueprintCallable)
+	void PreloadLoadingScreenAssets();
+
+	// Returns true while a travel started through TravelWithPreload hasn't reached LoadMap yet.
+	UFUNCTION(BlueprintCallable)
+	bool IsTravelPending() const;
+
+	// Prints the package report of the latest transition. Requires bTrackPackageLoads in settings.
+	void DumpPackageLoadReport(FOutputDevice& Ar, int32 TopN) const;
+
+	// Prints the peak memory of transitions, per map. Requires bTrackTransitionMemory in settings.
+	void DumpMemoryReport(FOutputDevice& Ar) const;
+
+	// Prints the synchronous loads that happened outside the loading screen, per map. Requires bTrackSyncLoadsOutsideLoadingScreen in settings.
+	void DumpSyncLoadReport(FOutputDevice& Ar) const;
+
+	// Prints the Slate time per frame spent while the loading screen was up, for each widget wrapping used so far.
+	void DumpSlateReport(FOutputDevice& Ar) const;
+
+	// Prints the load time history used to pick the presentation tier. Requires bUseTieredPresentation in settings.
+	void DumpLoadHistory(FOutputDevice& Ar) const;
+
+	// Prints the memory footprint and load time of the loading screen widget, and what each residency policy costs with them.
+	void DumpResidencyReport(FOutputDevice& Ar) const;
 
 private:
 	// CoreUObject hookups
 	void HandlePreLoadMap(const FWorldContext& WorldContext, const FString& MapName);
 	void HandlePostLoadMap(UWorld* World);
+	void HandleTravelFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ErrorString);
+
+	// Called when the destination of TravelWithPreload has finished async loading.
+	void HandleTravelPreloadCompleted(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result);
+
+	// Starts async loading PendingTravelMap, or travels right away if it can't be preloaded.
+	void StartTravelPreload();
+
+	// Hands the pending travel to the engine.
+	void IssuePendingTravel();
+
+	// Constructs the menu of a finished RequestMenuTransition and hands it to the caller.
+	void HandleMenuTransitionLoaded(int32 RequestId);
+
+	// Returns true if a menu requested through RequestMenuTransition has been loading for longer than the delay in settings.
+	// Sets LoadingScreenStateReason when waiting.
+	bool IsWaitingForMenuTransition();
+
+	// Called when a Game Feature plugin requested through LoadAndActivateGameFeatures has finished. Error is empty on success.
+	void HandleGameFeatureLoadComplete(const FString& PluginName, const FString& Error);
 
 	// Does multiple checks to determine if a loading screen is needed. 
 	bool CheckForDisplayReason();
 
 	void UpdateLoadingScreen();
 
+	// Publishes the current state for GetStateSnapshot. Called at the end of every update.
+	void PublishStateSnapshot();
+
+	// Applies the minimum on and off times and the coalescing window to what ShouldShowLoadingScreen wants, returning what to actually do.
+	bool ApplyVisibilityHysteresis(bool bWantsToShow);
+
 	// Checks if the widget should be removed because of loading being done.
 	bool ShouldShowLoadingScreen();
 
@@ -82,27 +258,286 @@ private:
 	// Hides the loading screeen if displayed by destroying it.
 	void HideLoadingScreen();
 
-	// Removes the widget from the viewport.
+	// Creates the widget for the tier and adds it to the viewport, replacing the one already there.
+	void AddLoadingScreenWidget(ELoadingScreenPresentationTier Tier);
+
+	// Wraps the widget according to WidgetWrapping in settings.
+	TSharedRef<SWidget> WrapLoadingScreenWidget(const TSharedRef<SWidget>& Content);
+
+	// Predicts how long loading the map will take and picks the tier to present it with. Sets PredictedLoadSecs.
+	ELoadingScreenPresentationTier ChoosePresentationTier(const FString& MapName);
+
+	// Adds the indicator once its delay has passed, and switches to the full widget if a short load turns out to be long. Called every update.
+	void UpdatePresentationTier();
+
+	// Removes the widget from the viewport, and unloads its assets unless the residency policy keeps them.
 	void RemoveWidget();
 
+	// Returns the widget class, finishing the preload if there is one and loading it synchronously otherwise.
+	TSubclassOf<UUserWidget> LoadWidgetClass();
+
+	// Draws the widget off-screen once, so that the first real show doesn't have to compile and upload its resources.
+	void PrewarmWidget();
+
+	// Starts timing a Slate frame while the loading screen is displayed.
+	void HandleSlatePreTick(float DeltaTime);
+
+	// Measures the time to the first painted frame of the loading screen, and how long Slate took to tick and paint each frame.
+	void HandleSlateWindowRendered(SWindow& Window, void* ViewportRHIPtr);
+
+	// Lets the widget assets held by WidgetAssetsHandle be garbage collected.
+	void ReleaseWidgetAssets();
+
+	// Records how long the widget assets took to load and measures what they take in memory.
+	void RecordWidgetLoad(double LoadSecs, bool bWasSynchronous);
+
 	// Does some performance optimisations during the loading screen, such as stopping geometry from being drawn on screen.
 	void ChangePerformanceSettings(bool bEnabingLoadingScreen);
 
+	// Returns true if a travel has been requested or a server is being connected to, but the engine hasn't started LoadMap yet.
+	// Prefetches the destination if enabled. Sets LoadingScreenStateReason when waiting.
+	bool IsWaitingForIntendedTravel(const FWorldContext& Context);
+
+	// Stops holding on to the destination prefetched for a travel intent.
+	void ResetTravelIntent();
+
+	// Returns true if World Partition is still streaming in the area around the streaming sources, or a required data layer isn't active yet.
+	// Sets LoadingScreenStateReason when waiting.
+	bool IsWaitingForWorldPartition(UWorld* World);
+
+	// Returns true on network clients until the local player has possessed a pawn and the actor count has stopped changing.
+	// Sets LoadingScreenStateReason when waiting.
+	bool IsWaitingForNetworkReadiness(UWorld* World);
+
+	// Returns true if a registered readiness provider is blocking. Only queries Polled providers and Push providers that changed,
+	// in priority order, stopping at the first one that blocks. Sets LoadingScreenStateReason when waiting.
+	bool IsWaitingForReadinessProviders();
+
+	// Returns true if streaming levels are still loading. Once they are all loaded, flushes any pending visibility in one go.
+	// Sets LoadingScreenStateReason when waiting.
+	bool IsWaitingForStreamingLevels(UWorld* World);
+
+	// Tells the texture streamer where the player is about to see the world from, without rendering it.
+	// Returns false if there is neither a player viewpoint nor a player start to prime from.
+	bool PrimeTextureStreaming();
+
+	// Keeps the assets the outgoing world shares with the destination map from being garbage collected by LoadMap, within the memory cap.
+	void RetainSharedAssets(const FWorldContext& WorldContext, const FString& MapName);
+
+	// Lets the retained assets be garbage collected again.
+	void ReleaseRetainedAssets();
+
+	// Returns the load budget of the map in seconds, or zero if it has none.
+	float GetLoadBudget(const FString& MapName) const;
+
+	// Compares the transition that just ended against its budget, and writes a diagnostic bundle if it went over.
+	void CheckLoadBudget();
+
+	// Lowers the screen percentage for the post-reveal ramp, if enabled in settings.
+	void BeginQualityRamp();
+
+	// Raises the screen percentage according to the frame time. Called every tick.
+	void UpdateQualityRamp();
+
+	// Restores the screen percentage to exactly what it was, ending the ramp.
+	void EndQualityRamp();
+
+	// Starts sampling the game thread for the hot-stack report, if enabled in settings.
+	void ArmStallWatchdog(const FString& MapName);
+
+	// Stops sampling and lets the watchdog write its report.
+	void DisarmStallWatchdog();
+
+	// Starts recording package loads for the transition, if enabled in settings. Does nothing if already recording.
+	void BeginPackageTracking(const FString& MapName);
+
+	// Stops recording package loads and stores the report, writing it to disk if enabled.
+	void EndPackageTracking();
+
 	// The displayed widget if any. Used to update the widget manually. Do not confuse with the class that the widget is created from!
 	TSharedPtr<SWidget> LoadingScreenWidget;
 
+	// Keeps the widget class and the assets it references loaded between transitions, according to the residency policy.
+	TSharedPtr<FStreamableHandle> WidgetAssetsHandle;
+
+	// How long the widget assets took to load the last time, and whether that blocked the game thread. Negative until first loaded.
+	double WidgetLoadSecs = -1.0;
+	bool bWidgetLoadWasSynchronous = false;
+
+	// Set when the widget is added on show, until Slate has painted the game window with it.
+	bool bIsAwaitingFirstPaint = false;
+	float LastTimeToFirstPaintSecs = -1.0f;
+
+	// Whether PrewarmWidget ran, for telling cold shows from warm ones in the log.
+	bool bWasWidgetPrewarmed = false;
+
+	struct FSlateFrameStats
+	{
+		int32 NumFrames = 0;
+		double TotalSecs = 0.0;
+		double PeakSecs = 0.0;
+
+		double GetAverageSecs() const { return NumFrames > 0 ? TotalSecs / NumFrames : 0.0; }
+	};
+
+	// When Slate started the current frame while the loading screen is displayed. Negative when not timing.
+	double SlateFrameStartTime = -1.0;
+
+	// Game thread time Slate spent ticking and painting the game window while displayed, for the current session and per wrapping.
+	FSlateFrameStats SessionSlateStats;
+	TMap<ELoadingScreenWidgetWrapping, FSlateFrameStats> SlateStatsPerWrapping;
+
+	// How the displayed widget is wrapped.
+	ELoadingScreenWidgetWrapping SessionWidgetWrapping = {};
+
+	// Estimated memory of the widget assets, and how many packages they are in. Negative until first measured.
+	int64 WidgetFootprintBytes = -1;
+	int32 WidgetFootprintPackages = 0;
+
 	bool bIsDisplayingLoadingScreen;
 
 	// The reason for the latest change in the loading screens visibility state. Used for debugging purposes only!
 	FString LoadingScreenStateReason;
 
+	// The phase matching LoadingScreenStateReason. Recorded in TransitionTimeline while the screen is displayed.
+	ELoadingScreenPhase DisplayPhase = ELoadingScreenPhase::None;
+
+	// Which phases the current or latest loading screen session went through.
+	FLoadingScreenTransitionTimeline TransitionTimeline;
+
+	// How the current or latest session is presented, and the load time it was chosen from. Negative when there was nothing to predict from.
+	ELoadingScreenPresentationTier PresentationTier = ELoadingScreenPresentationTier::Full;
+	float PredictedLoadSecs = -1.0f;
+
+	// The map passed to PreLoadMap, used to name the transition.
+	FString LoadMapName;
+
 	double LoadingScreenLastDismissedTimestamp = -1.0;
 
+	// When the loading screen was last shown and hidden, for the minimum on and off times.
+	double LoadingScreenShownTimestamp = -1.0;
+	double LoadingScreenHiddenTimestamp = -1.0;
+
+	// When the screen started wanting to hide while displayed, or to show while hidden. Negative when it doesn't.
+	double PendingHideTimestamp = -1.0;
+	double PendingShowTimestamp = -1.0;
+
+	int32 NumFlapsPrevented = 0;
+	int32 NumFlapsPreventedThisSession = 0;
+
 	bool bIsDisplayedByGameLogic = false;
 
 	// Set by user when calling ForceDisplayStateByGameLogic
 	FString UserSpecifiedLoadingScreenReason;
 
+	// True between PreLoadMap and PostLoadMap. The old world is still valid at PreLoadMap, so it can't be used to detect the load.
+	bool bIsInLoadMap = false;
+
+	// When we started waiting for World Partition streaming, used for the timeout. Negative when not waiting, zero once timed out.
+	double WorldPartitionWaitStartTimestamp = -1.0;
+
+	// When we started waiting for streaming levels, used for the timeout. Negative when not waiting, zero once timed out.
+	double StreamingLevelsWaitStartTimestamp = -1.0;
+
+	// When we started waiting for network readiness, used for the timeout. Negative when not waiting, zero once timed out.
+	double NetworkReadinessWaitStartTimestamp = -1.0;
+
+	// The replicated actor count at the last check, and when it last changed. Negative count until possession.
+	int32 NetworkActorCount = -1;
+	double NetworkActorCountChangedTimestamp = 0.0;
+
+	// Level streaming granularities raised while the loading screen is up.
+	TSharedPtr<FLoadingScreenCVarOverrides> LevelStreamingOverrides;
+
+	// The screen percentage lowered while ramping up after the reveal.
+	TSharedPtr<FLoadingScreenCVarOverrides> QualityRampOverrides;
+
+	// How far the post-reveal ramp has come, 0 to 1. Negative when not ramping.
+	float QualityRampProgress = -1.0f;
+
+	// The user's screen percentage, the one currently applied, and when the ramp started.
+	float QualityRampTargetPercentage = 100.0f;
+	float QualityRampAppliedPercentage = 100.0f;
+	double QualityRampStartTimestamp = 0.0;
+
+	ELoadingScreenTravelState TravelState = ELoadingScreenTravelState::None;
+
+	// The long package name and URL options of the travel started by TravelWithPreload.
+	FString PendingTravelMap;
+	FString PendingTravelOptions;
+
+	// The destination prefetched because a travel was requested, empty if none. Cleared once the travel loads or fails.
+	FString IntendedTravelMap;
+
+	// When and on which frame the current travel intent was first seen, to log how far ahead of LoadMap the screen went up. Negative when none.
+	double TravelIntentTimestamp = -1.0;
+	uint64 TravelIntentFrame = 0;
+
+	// Game Feature plugins requested through LoadAndActivateGameFeatures that haven't finished yet.
+	TSet<FString> PendingGameFeaturePlugins;
+
+	struct FReadinessProviderEntry
+	{
+		TWeakObjectPtr<UObject> Object;
+		ILoadingScreenReadinessProvider* Interface = nullptr;
+		int32 Priority = 0;
+		bool bIsPush = false;
+
+		// Push providers only. The answer from the last query, and whether it needs to be asked again.
+		bool bNeedsQuery = true;
+		bool bCachedBlocking = false;
+		FString CachedReason;
+	};
+
+	// Registered readiness providers, highest priority first.
+	TArray<FReadinessProviderEntry> ReadinessProviders;
+
+	struct FMenuTransitionRequest
+	{
+		int32 RequestId = 0;
+		TSoftClassPtr<UUserWidget> WidgetClass;
+		TWeakObjectPtr<APlayerController> OwningPlayer;
+		FOnMenuTransitionCompleteSignature OnComplete;
+		TSharedPtr<FStreamableHandle> Handle;
+		double StartTime = 0.0;
+	};
+
+	// Menus requested through RequestMenuTransition that are still loading.
+	TArray<FMenuTransitionRequest> PendingMenuTransitions;
+	int32 NextMenuTransitionRequestId = 0;
+
+	// Keeps the assets of each opened menu loaded while the menu exists. Dropped in Tick once the widget is gone.
+	TArray<TPair<TWeakObjectPtr<UUserWidget>, TSharedPtr<FStreamableHandle>>> MenuAssetHandles;
+
+	// Keeps the preloaded or prefetched destination from being garbage collected before LoadMap picks it up. Released on PostLoadMap.
+	UPROPERTY(Transient)
+	TObjectPtr<UWorld> PreloadedWorld;
+
+	// Assets shared between the outgoing and the destination map, kept alive through LoadMap. Released when the screen is hidden.
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UObject>> RetainedAssets;
+
+	// Samples the game thread during map loads. Only created if enabled in settings.
+	TSharedPtr<FLoadingScreenStallWatchdog> StallWatchdog;
+
+	// Records package loads during transitions. Only created if enabled in settings.
+	TSharedPtr<FLoadingScreenPackageTracker> PackageTracker;
+
+	// The package report of the latest finished transition.
+	TSharedPtr<FLoadingScreenPackageReport> LastPackageReport;
+
+	// Records sync loads that happen while the loading screen is down. Only created if enabled in settings.
+	TSharedPtr<FLoadingScreenSyncLoadTracker> SyncLoadTracker;
+
+	// Samples memory during transitions. Only created if enabled in settings.
+	TSharedPtr<FLoadingScreenMemoryTracker> MemoryTracker;
+
+	// Load times per map, for picking the presentation tier. Only created if enabled in settings.
+	TSharedPtr<FLoadingScreenLoadHistory> LoadHistory;
+
+	// Applies the tick policies registered through RegisterTickThrottle and RegisterThrottledTicker.
+	TSharedPtr<FLoadingScreenTickThrottler> TickThrottler;
+
 public: 
 
 	// Called when the loading screen is waiting for HoldLoadingScreenAdditionalSecs to pass. Passes said value.
@@ -0,0 +1,86 @@
+// Copyright (c) 2025, Oliver sterlund Stare. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "LoadingScreenTransitionTimeline.generated.h"
+
+// What the loading screen is currently waiting for. Ordered roughly as they occur during a transition.
+UENUM(BlueprintType)
+enum class ELoadingScreenPhase : uint8
+{
+	None,
+	// Forced on in settings.
+	Forced,
+	PreloadingTravel,
+	WaitingForTravel,
+	LoadingMap,
+	// No world, or the world hasn't begun play.
+	WaitingForWorld,
+	WorldPartitionStreaming,
+	StreamingLevels,
+	// Network clients only. Waiting for possession and initial replication.
+	NetworkReplication,
+	GameFeatures,
+	// A menu requested through RequestMenuTransition is taking longer than MenuTransitionLoadingScreenDelaySecs to load.
+	MenuTransition,
+	// A registered ILoadingScreenReadinessProvider is blocking.
+	ReadinessProviders,
+	// Requested by ForceDisplayStateByGameLogic.
+	GameLogic,
+	// HoldLoadingScreenAdditionalSecs after everything else is done.
+	AdditionalHold,
+	// Kept up for MinimumDisplaySecs or CoalescingWindowSecs after every reason to show went away.
+	VisibilityHysteresis,
+};
+
+// A continuous stretch of time spent in one phase.
+struct FLoadingScreenPhaseSpan
+{
+	ELoadingScreenPhase Phase = ELoadingScreenPhase::None;
+	double StartTime = 0.0;
+	double EndTime = 0.0;
+
+	double GetDuration() const { return EndTime - StartTime; }
+};
+
+/*
+* Records which phases a single loading screen session went through, and for how long.
+* Consecutive updates in the same phase extend the current span.
+*/
+struct VERTICALSLICE_API FLoadingScreenTransitionTimeline
+{
+	// The map being transitioned to, or the current map if the screen was shown by game logic.
+	FString MapName;
+
+	double StartTime = 0.0;
+	double EndTime = 0.0;
+
+	TArray<FLoadingScreenPhaseSpan> Spans;
+
+	// Clears the timeline and starts recording.
+	void Begin(const FString& InMapName);
+
+	// Closes the current span if the phase changed, and opens a new one.
+	void EnterPhase(ELoadingScreenPhase Phase);
+
+	// Closes the current span and stops recording.
+	void End();
+
+	bool IsActive() const { return bIsActive; }
+
+	ELoadingScreenPhase GetCurrentPhase() const;
+
+	// Total time of the session, up until now if it's still active.
+	double GetDuration() const;
+
+	// Total time spent in the phase, summed over all of its spans.
+	double GetPhaseDuration(ELoadingScreenPhase Phase) const;
+
+	// One line summary with the time spent in each phase, in the order they were first entered.
+	FString ToString() const;
+
+private:
+	bool bIsActive = false;
+};